@@ -0,0 +1,95 @@
+#include "benchmarks.hpp"
+
+#include "MCTS.hpp"
+#include "connect4_evaluator.hpp"
+
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace Benchmark {
+
+    namespace {
+
+        /**
+         * \brief Connect 4 heuristic with a fixed cost per call, standing for the launch and transfer cost of a model inference
+         */
+        class CallCostEvaluator :
+            public MCTS::ILeaf_Evaluator
+        {
+            public:
+                CallCostEvaluator(double callSeconds) : _evaluator(true), _callSeconds(callSeconds), _calls(0) {}
+
+                virtual void evaluate(const std::vector<const MCTS::IGame_State*>& states, std::vector<float>& values, std::vector<std::vector<float>>* priors) {
+                    Timer timer;
+                    while(timer.elapsed_seconds() < _callSeconds)
+                        ;
+                    _calls += 1;
+                    _evaluator.evaluate(states, values, priors);
+                }
+
+                virtual bool has_priors() const {
+                    return _evaluator.has_priors();
+                }
+
+                unsigned int get_calls() const { return _calls; }
+
+            private:
+                MCTS::Connect4Evaluator _evaluator;
+                double _callSeconds;
+                unsigned int _calls;
+        };
+
+    }
+
+    int run_batched_benchmark(int argc, char** argv) {
+        const unsigned int iterations = get_argument(argc, argv, 1, 20000);
+        const unsigned int positions = get_argument(argc, argv, 2, 8);
+        const unsigned int callMicroseconds = get_argument(argc, argv, 3, 20);
+
+        std::cout << "Connect 4, " << positions << " positions, " << iterations << " iterations, evaluator call cost " << callMicroseconds << "us" << std::endl;
+        std::cout << std::fixed << std::setprecision(3);
+        std::cout << "leaf evaluation     | iterations/s | evaluator calls | same move as batch 1" << std::endl;
+
+        std::vector<unsigned int> referenceMoves;
+        for(unsigned int batchSize : {0u, 1u, 4u, 16u, 64u}) {
+            //batch size 0: random rollouts
+            double seconds = 0;
+            unsigned int calls = 0, sameMove = 0;
+            for(unsigned int position = 0; position < positions; ++position) {
+                MCTS::SearchConfig config;
+                config.evaluationBatchSize = batchSize;
+                //the evaluator priors order the expansions
+                config.useMovePriorOrder = (batchSize > 0);
+                MCTS::MCTS tree(make_connect4_position(position % 12, position + 1), config);
+                MCTS::seed_random(position);
+                CallCostEvaluator evaluator(callMicroseconds * 1e-6);
+
+                Timer timer;
+                const unsigned int move = (batchSize == 0) ? tree.search_best_move(iterations) : tree.search_best_move_batched(iterations, evaluator);
+                seconds += timer.elapsed_seconds();
+                calls += evaluator.get_calls();
+
+                if(batchSize == 1)
+                    referenceMoves.push_back(move);
+                else if(batchSize > 1)
+                    sameMove += (move == referenceMoves[position]) ? 1 : 0;
+            }
+
+            std::cout << (batchSize == 0 ? "random rollouts    " : "batch of ") << std::left;
+            if(batchSize > 0)
+                std::cout << std::setw(10) << batchSize;
+            std::cout << std::right
+                << " | " << std::setw(12) << static_cast<unsigned int>(positions * iterations / seconds)
+                << " | " << std::setw(15) << calls
+                << " | ";
+            if(batchSize > 1)
+                std::cout << sameMove << "/" << positions;
+            else
+                std::cout << "-";
+            std::cout << std::endl;
+        }
+        return 0;
+    }
+
+} /* Benchmark */
@@ -0,0 +1,62 @@
+#include "benchmarks.hpp"
+
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+    struct Suite {
+        const char* name;
+        int (*run)(int argc, char** argv);
+        const char* description;
+    };
+
+    const Suite suites[] = {
+        {"rave", Benchmark::run_rave_benchmark, "[iterations] [positions]: iterations-to-stable-best-move, UCT against RAVE"},
+        {"widening", Benchmark::run_widening_benchmark, "[iterations] [games]: depth and memory of progressive widening on a wide synthetic game"},
+        {"pipeline", Benchmark::run_pipeline_benchmark, "[iterations] [rollout threads] [queue depth] [selection threads]: pipelined search throughput and stage utilization"},
+        {"earlystop", Benchmark::run_early_stop_benchmark, "[iterations] [positions] [stable window]: iterations and latency saved by the early stop rules"},
+        {"connectk", Benchmark::run_connect_k_benchmark, "[games] [iterations]: playout and search speed of Puissance4 and the ConnectK variants"},
+        {"gomoku", Benchmark::run_gomoku_benchmark, "[iterations] [opening moves]: search speed and tree shape on 15x15 Gomoku"},
+        {"movegen", Benchmark::run_move_generation_benchmark, "[games]: do_move speed of the bundled games"},
+        {"compact", Benchmark::run_compact_benchmark, "[build iterations] [search iterations] [descents]: selection descents and search speed of a scattered and a compacted tree"},
+        {"teardown", Benchmark::run_teardown_benchmark, "[iterations] [games] [tree iterations]: move to move latency and destruction stall, freeing the trees in the caller or in background"},
+        {"batched", Benchmark::run_batched_benchmark, "[iterations] [positions] [call cost us]: speed of the batched leaf evaluation against random rollouts"},
+        {"interleaved", Benchmark::run_interleaved_benchmark, "[tree nodes] [iterations] [batch size]: batched search speed with plain and interleaved prefetching descents on a large tree"},
+        {"treestats", Benchmark::run_tree_stats_benchmark, "[iterations] [json file]: shape and memory report of a Connect 4 tree"},
+        {"export", Benchmark::run_export_benchmark, "[iterations] [directory]: time to dump a Connect 4 tree with show_tree and the JSON and DOT exports"},
+        {"counters", Benchmark::run_counters_benchmark, "[tree iterations] [iterations]: time and hardware counters (perf_event_open) of each search phase, per iteration"},
+        {"symmetry", Benchmark::run_symmetry_benchmark, "[iterations] [max solve iterations]: nodes to solve TicTacToe and Connect 4 opening tree, with and without the symmetric moves"},
+        {"fpu", Benchmark::run_fpu_benchmark, "[iterations] [games]: first visits, depth and move quality of UCT and PUCT, with and without first play urgency, on a wide synthetic game"},
+        {"expanding", Benchmark::run_expanding_rollout_benchmark, "[iterations] [positions] [node budget]: speed, tree memory and move quality of the expanding rollouts, by nodes kept per rollout"},
+        {"timemanager", Benchmark::run_time_manager_benchmark, "[games] [game ms] [increment ms] [flat expected moves]: strength of the adaptive time manager against flat budgets, on the same game clock"},
+        {"multiprocess", Benchmark::run_multiprocess_benchmark, "[iterations] [positions] [max workers]: root parallel search in worker processes merged through shared memory, by worker count"},
+        {"packed", Benchmark::run_packed_tree_benchmark, "[iterations] [positions]: speed, memory per node and move quality of the Node tree against the 20 byte nodes of PackedTree"},
+    };
+
+    void show_usage(const char* program) {
+        std::cout << "Usage: " << program << " <suite> [arguments]" << std::endl;
+        for(const Suite& suite : suites)
+            std::cout << "    " << suite.name << " " << suite.description << std::endl;
+    }
+
+}
+
+
+
+int main(int argc, char** argv) {
+    if(argc < 2) {
+        show_usage(argv[0]);
+        return 1;
+    }
+
+    for(const Suite& suite : suites) {
+        if(strcmp(suite.name, argv[1]) == 0)
+            //suite arguments start after the suite name
+            return suite.run(argc - 1, argv + 1);
+    }
+
+    std::cerr << "Unknown benchmark suite " << argv[1] << std::endl;
+    show_usage(argv[0]);
+    return 1;
+}
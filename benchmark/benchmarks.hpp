@@ -0,0 +1,226 @@
+#ifndef MCTS_BENCHMARKS_HPP
+#define MCTS_BENCHMARKS_HPP
+
+#include "node.hpp"
+#include "puissance4.hpp"
+#include "random.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * \file    benchmarks.hpp
+ * \author  Baptiste Hudyma
+ * \version 1.0
+ * \date    11 mars 2021
+ *
+ * \brief   Shared helpers and entry points of the benchmark suites
+ */
+
+namespace Benchmark {
+
+    /**
+     * \brief Measure the wall time since construction
+     */
+    class Timer {
+        public:
+            Timer() : _start(std::chrono::steady_clock::now()) {}
+
+            double elapsed_seconds() const {
+                return std::chrono::duration<double>(std::chrono::steady_clock::now() - _start).count();
+            }
+
+        private:
+            std::chrono::steady_clock::time_point _start;
+    };
+
+    /**
+     * \brief Create a Connect 4 position by playing random moves from the empty board
+     *
+     * \param[in] randomMoves   Number of moves to play
+     * \param[in] seed          Seed of the move selection
+     *
+     * \return A new game state, never game over
+     */
+    inline MCTS::Puissance4* make_connect4_position(unsigned int randomMoves, unsigned int seed) {
+        MCTS::seed_random(seed);
+        MCTS::Puissance4* state = new MCTS::Puissance4();
+        for(unsigned int i = 0; i < randomMoves; ++i) {
+            MCTS::Puissance4* next = state->do_move(MCTS::random_index(state->get_move_count()));
+            if(next->is_game_over()) {
+                //keep the last playable position
+                delete next;
+                break;
+            }
+            delete state;
+            state = next;
+        }
+        return state;
+    }
+
+    /**
+     * \brief Shape and estimated size of a search tree
+     */
+    struct TreeShape {
+        unsigned int nodeCount;
+        unsigned int maxDepth;
+        double meanDepth;           //mean depth of the nodes
+        unsigned int maxChildren;
+        double meanChildren;        //mean children count of the nodes with children
+        double treeBytes;           //estimated heap size of the tree
+    };
+
+    /**
+     * \brief Walk a tree iteratively to measure its shape
+     *
+     * \param[in] root         Root of the tree
+     * \param[in] stateBytes   Size of the game state objects
+     */
+    inline TreeShape measure_tree_shape(const MCTS::Node* root, size_t stateBytes) {
+        TreeShape shape = {0, 0, 0.0, 0, 0.0, 0.0};
+        double depthSum = 0;
+        unsigned int innerNodes = 0;
+        unsigned long long childrenSum = 0;
+
+        std::vector<std::pair<const MCTS::Node*, unsigned int>> toVisit;
+        toVisit.emplace_back(root, 0);
+        while(not toVisit.empty()) {
+            auto [node, depth] = toVisit.back();
+            toVisit.pop_back();
+
+            shape.nodeCount += 1;
+            shape.maxDepth = std::max(shape.maxDepth, depth);
+            depthSum += depth;
+            //node, game state, list element of the parent and the unexplored children reserved at construction
+            shape.treeBytes += sizeof(MCTS::Node) + stateBytes + 3 * sizeof(void*) + node->get_move_count() * sizeof(unsigned int);
+
+            const unsigned int childCount = node->get_children().size();
+            if(childCount > 0) {
+                innerNodes += 1;
+                childrenSum += childCount;
+                shape.maxChildren = std::max(shape.maxChildren, childCount);
+            }
+            for(const MCTS::Node* child : node->get_children())
+                toVisit.emplace_back(child, depth + 1);
+        }
+        shape.meanDepth = depthSum / shape.nodeCount;
+        shape.meanChildren = (innerNodes > 0) ? static_cast<double>(childrenSum) / innerNodes : 0.0;
+        return shape;
+    }
+
+    /**
+     * \brief Read an optional unsigned integer argument
+     */
+    inline unsigned int get_argument(int argc, char** argv, int index, unsigned int defaultValue) {
+        if(index < argc)
+            return std::stoul(argv[index]);
+        return defaultValue;
+    }
+
+    /**
+     * \brief Compare the iterations needed to settle on a best move with plain UCT and RAVE
+     */
+    int run_rave_benchmark(int argc, char** argv);
+
+    /**
+     * \brief Compare the tree depth, memory and speed of full expansion and progressive widening on a wide synthetic game
+     */
+    int run_widening_benchmark(int argc, char** argv);
+
+    /**
+     * \brief Compare the sequential and pipelined search throughput, and report the pipeline stages utilization
+     */
+    int run_pipeline_benchmark(int argc, char** argv);
+
+    /**
+     * \brief Measure the iterations and latency saved by the early stop rules, and how often they change the chosen move
+     */
+    int run_early_stop_benchmark(int argc, char** argv);
+
+    /**
+     * \brief Compare the random playout and search speed of Puissance4 and the ConnectK variants
+     */
+    int run_connect_k_benchmark(int argc, char** argv);
+
+    /**
+     * \brief Measure the search speed and tree shape on 15x15 Gomoku, with more than 200 children per node
+     */
+    int run_gomoku_benchmark(int argc, char** argv);
+
+    /**
+     * \brief Measure the do_move speed of the bundled games
+     */
+    int run_move_generation_benchmark(int argc, char** argv);
+
+    /**
+     * \brief Measure the cost of compacting a large tree, and the speed of walking and searching it before and after
+     */
+    int run_compact_benchmark(int argc, char** argv);
+
+    /**
+     * \brief Measure the move to move latency and the tree destruction stall, with the trees freed by the caller or in background
+     */
+    int run_teardown_benchmark(int argc, char** argv);
+
+    /**
+     * \brief Compare random rollouts and the batched heuristic evaluation of the leaves, for several batch sizes
+     */
+    int run_batched_benchmark(int argc, char** argv);
+
+    /**
+     * \brief Compare the batched search speed with plain and interleaved prefetching descents on a large tree
+     */
+    int run_interleaved_benchmark(int argc, char** argv);
+
+    /**
+     * \brief Build a tree and report its shape and memory use, optionally as a JSON file
+     */
+    int run_tree_stats_benchmark(int argc, char** argv);
+
+    /**
+     * \brief Compare the time to dump a large tree with show_tree and with the JSON and DOT exports
+     */
+    int run_export_benchmark(int argc, char** argv);
+
+    /**
+     * \brief Report the time and hardware counters of each search phase, per iteration
+     */
+    int run_counters_benchmark(int argc, char** argv);
+
+    /**
+     * \brief Compare the nodes needed to solve TicTacToe and the spread of a Connect 4 opening tree, with and without the symmetric moves
+     */
+    int run_symmetry_benchmark(int argc, char** argv);
+
+    /**
+     * \brief Compare the first visits, depth and move quality of UCT and PUCT, with and without first play urgency, on a wide synthetic game
+     */
+    int run_fpu_benchmark(int argc, char** argv);
+
+    /**
+     * \brief Chart the search speed, tree memory and move quality of the expanding rollouts against the nodes kept per rollout
+     */
+    int run_expanding_rollout_benchmark(int argc, char** argv);
+
+    /**
+     * \brief Play Connect 4 games on a game clock between the adaptive and the flat time manager
+     */
+    int run_time_manager_benchmark(int argc, char** argv);
+
+    /**
+     * \brief Compare the latency, iterations and move agreement of the root parallel search against its worker processes
+     */
+    int run_multiprocess_benchmark(int argc, char** argv);
+
+    /**
+     * \brief Compare the speed, memory per node and move quality of the Node tree and the PackedTree
+     */
+    int run_packed_tree_benchmark(int argc, char** argv);
+
+} /* Benchmark */
+
+#endif
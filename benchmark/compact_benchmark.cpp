@@ -0,0 +1,100 @@
+#include "benchmarks.hpp"
+
+#include "MCTS.hpp"
+
+#include <iomanip>
+#include <algorithm>
+#include <iostream>
+#include <list>
+#include <vector>
+
+namespace Benchmark {
+
+    namespace {
+
+        /**
+         * \brief Root to leaf descents picking each child with a probability proportional to its visits, like the traffic of the UCT selection.
+         *        The statistics of every child on the way are read, like the UCT score computation
+         *
+         * \return A checksum of the read statistics
+         */
+        double weighted_descents(const MCTS::Node* root, unsigned int descents) {
+            double checksum = 0;
+            for(unsigned int i = 0; i < descents; ++i) {
+                const MCTS::Node* node = root;
+                while(not node->get_children().empty()) {
+                    unsigned int picked = MCTS::random_index(node->get_visit_count());
+                    const MCTS::Node* next = node->get_children().back();
+                    for(const MCTS::Node* child : node->get_children()) {
+                        checksum += child->get_score() / (child->get_visit_count() + 1);
+                        if(next == node->get_children().back() and picked < child->get_visit_count())
+                            next = child;
+                        picked -= std::min(picked, child->get_visit_count());
+                    }
+                    node = next;
+                }
+            }
+            return checksum;
+        }
+
+    }
+
+    int run_compact_benchmark(int argc, char** argv) {
+        const unsigned int buildIterations = get_argument(argc, argv, 1, 300000);
+        const unsigned int searchIterations = get_argument(argc, argv, 2, 200000);
+        const unsigned int descents = get_argument(argc, argv, 3, 500000);
+        const unsigned int rounds = 3;
+
+        struct Mode {
+            const char* name;
+            bool compact;
+            MCTS::TreeLayout layout;
+        };
+        const std::vector<Mode> modes = {
+            {"scattered", false, MCTS::TreeLayout::BreadthFirst},
+            {"breadth first", true, MCTS::TreeLayout::BreadthFirst},
+            {"visit weighted", true, MCTS::TreeLayout::VisitWeighted},
+        };
+
+        std::cout << "Connect 4, tree of " << buildIterations << " iterations, best of " << rounds << " rounds of "
+            << descents << " visit weighted descents, and " << searchIterations << " more search iterations" << std::endl;
+        std::cout << std::fixed << std::setprecision(3);
+        std::cout << "layout          | compaction | descents/s | search iterations/s" << std::endl;
+
+        for(const Mode& mode : modes) {
+            //same seed for every mode: the trees are identical, only their memory layout changes
+            MCTS::MCTS tree(make_connect4_position(0, 1));
+            MCTS::seed_random(1);
+            tree.run_iterations(buildIterations);
+
+            double compactionSeconds = 0;
+            if(mode.compact) {
+                Timer timer;
+                tree.compact(mode.layout);
+                compactionSeconds = timer.elapsed_seconds();
+            }
+
+            double descentSeconds = 0;
+            for(unsigned int round = 0; round < rounds; ++round) {
+                MCTS::seed_random(2);
+                Timer descentTimer;
+                volatile double checksum = weighted_descents(tree.get_root(), descents);
+                (void)checksum;
+                const double seconds = descentTimer.elapsed_seconds();
+                descentSeconds = (round == 0) ? seconds : std::min(descentSeconds, seconds);
+            }
+
+            MCTS::seed_random(3);
+            Timer searchTimer;
+            tree.run_iterations(searchIterations);
+            const double searchSeconds = searchTimer.elapsed_seconds();
+
+            std::cout << std::left << std::setw(15) << mode.name << std::right
+                << " | " << std::setw(9) << compactionSeconds << "s"
+                << " | " << std::setw(10) << static_cast<unsigned int>(descents / descentSeconds)
+                << " | " << std::setw(10) << static_cast<unsigned int>(searchIterations / searchSeconds) << std::endl;
+        }
+        return 0;
+    }
+
+} /* Benchmark */
@@ -0,0 +1,276 @@
+#include "connect4_match.hpp"
+#include "benchmarks.hpp"
+
+#include "MCTS.hpp"
+#include "connect4_evaluator.hpp"
+#include "random.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <thread>
+
+namespace Benchmark {
+
+    namespace {
+
+        //iterations between two checks of the time budget
+        const unsigned int TIME_BUDGET_CHUNK = 64;
+
+        /**
+         * \brief One side of a game: a tree kept from move to move, and its evaluator
+         */
+        class Player {
+            public:
+                Player(const PlayerSettings& settings, MCTS::IGame_State* initialState) :
+                    _settings(settings),
+                    _tree(initialState, settings.config),
+                    _evaluator(settings.config.useMovePriorOrder),
+                    _timeManager(settings.timeControl)
+                {}
+
+                /**
+                 * \brief Search the current position with the budget of this player
+                 *
+                 * \return Index of the chosen move
+                 */
+                unsigned int choose_move() {
+                    //the random rollout searches on a game clock or an iteration budget go through the early stop rules of the tree
+                    if(_settings.useGameClock and _settings.rollout == RolloutMode::Random) {
+                        return _tree.search_best_move(_timeManager);
+                    }
+                    if(_settings.moveMilliseconds <= 0.0 and _settings.rollout == RolloutMode::Random) {
+                        //unlike search_best_move, does not print the closed root message
+                        return _tree.search_best_move_until(std::chrono::steady_clock::time_point::max(), std::max(1u, _settings.config.iterationsPerMove));
+                    }
+                    if(_settings.useGameClock) {
+                        //the batched search has no deadline: run it by chunks on the time manager budget
+                        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+                        _timeManager.start_move();
+                        double elapsed = 0.0;
+                        do {
+                            this->search(TIME_BUDGET_CHUNK);
+                            elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                        } while(elapsed < _timeManager.get_move_budget(_tree.get_root()));
+                        _timeManager.end_move(elapsed);
+                    }
+                    else if(_settings.moveMilliseconds <= 0.0) {
+                        this->search(std::max(1u, _settings.config.iterationsPerMove));
+                    }
+                    else {
+                        const double deadline = thread_cpu_seconds() + _settings.moveMilliseconds / 1000.0;
+                        do {
+                            this->search(TIME_BUDGET_CHUNK);
+                        } while(thread_cpu_seconds() < deadline and not _tree.get_root()->is_closed());
+                    }
+
+                    MCTS::Node* bestChild = _tree.get_best_move();
+                    return (bestChild == nullptr) ? 0 : bestChild->get_move_index();
+                }
+
+                void play(unsigned int moveIndex) {
+                    _tree.advance_root(moveIndex);
+                }
+
+                bool is_out_of_time() const {
+                    return _settings.useGameClock and _timeManager.has_flagged();
+                }
+
+            private:
+                void search(unsigned int iterations) {
+                    if(_settings.rollout == RolloutMode::Heuristic)
+                        _tree.search_best_move_batched(iterations, _evaluator);
+                    else
+                        //a chunk of a CPU time budget: run_iterations does not print the closed root message of search_best_move
+                        _tree.run_iterations(iterations);
+                }
+
+                const PlayerSettings& _settings;
+                MCTS::MCTS _tree;
+                MCTS::Connect4Evaluator _evaluator;
+                MCTS::TimeManager _timeManager;
+        };
+
+    }
+
+    double thread_cpu_seconds() {
+        timespec time;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+        return time.tv_sec + time.tv_nsec * 1e-9;
+    }
+
+    bool set_player_option(PlayerSettings& player, const std::string& name, const std::string& value) {
+        if(name == "time-ms") {
+            char* end = nullptr;
+            const double milliseconds = std::strtod(value.c_str(), &end);
+            if(value.empty() or *end != '\0' or milliseconds < 0.0)
+                return false;
+            player.moveMilliseconds = milliseconds;
+            return true;
+        }
+        if(name == "game-ms" or name == "increment-ms") {
+            char* end = nullptr;
+            const unsigned long milliseconds = std::strtoul(value.c_str(), &end, 10);
+            if(value.empty() or *end != '\0' or value[0] == '-')
+                return false;
+            if(name == "game-ms")
+                player.timeControl.gameMilliseconds = milliseconds;
+            else
+                player.timeControl.incrementMilliseconds = milliseconds;
+            player.useGameClock = true;
+            return true;
+        }
+        if(name == "time-manager") {
+            if(value != "adaptive" and value != "flat")
+                return false;
+            player.timeControl.adaptive = (value == "adaptive");
+            return true;
+        }
+        if(name == "rollout") {
+            if(value != "random" and value != "heuristic")
+                return false;
+            player.rollout = (value == "random") ? RolloutMode::Random : RolloutMode::Heuristic;
+            return true;
+        }
+        return MCTS::set_search_option(player.config, name, value);
+    }
+
+    std::string get_unapplied_options(const PlayerSettings& player) {
+        //the chunked searches (batched rollouts, CPU time budget) choose the best move without the early stop rules
+        if(not player.config.useEarlyStop)
+            return std::string();
+        if(player.rollout == RolloutMode::Heuristic)
+            return "--early-stop is not applied by the heuristic rollouts";
+        if(not player.useGameClock and player.moveMilliseconds > 0.0)
+            return "--early-stop is not applied on a CPU time budget (time-ms), only on an iteration budget or a game clock";
+        return std::string();
+    }
+
+    void show_player_options(std::ostream& stream, const std::string& prefix, const PlayerSettings& defaults) {
+        stream << "  " << std::left << std::setw(28) << ("--" + prefix + "time-ms V") << "thread CPU time per move in milliseconds, replaces the iterations";
+        if(defaults.moveMilliseconds > 0.0)
+            stream << " (" << defaults.moveMilliseconds << ")";
+        stream << std::endl
+               << "  " << std::setw(28) << ("--" + prefix + "game-ms V") << "game clock in milliseconds, spent by a TimeManager, replaces the other budgets" << std::endl
+               << "  " << std::setw(28) << ("--" + prefix + "increment-ms V") << "milliseconds added to the game clock after each move (" << defaults.timeControl.incrementMilliseconds << ")" << std::endl
+               << "  " << std::setw(28) << ("--" + prefix + "time-manager V") << "adaptive or flat budget per move (" << (defaults.timeControl.adaptive ? "adaptive" : "flat") << ")" << std::endl
+               << "  " << std::setw(28) << ("--" + prefix + "rollout V") << std::right << "random or heuristic (random)" << std::endl;
+        std::ostringstream searchOptions;
+        MCTS::show_search_options(searchOptions, prefix, defaults.config);
+        //the time budget of a player replaces the wall clock one
+        std::istringstream lines(searchOptions.str());
+        std::string line;
+        while(std::getline(lines, line)) {
+            if(line.find("--" + prefix + "time-ms ") == std::string::npos)
+                stream << line << std::endl;
+        }
+    }
+
+    GameResult play_game(const PlayerSettings players[2], unsigned int openingMoves, unsigned int seed, unsigned int gameIndex) {
+        //both games of a pair start from the same opening, with the colors swapped
+        const unsigned int pairIndex = gameIndex / 2;
+        const unsigned int playerOfX = gameIndex % 2;   //0 if A plays X
+        const unsigned int openingSeed = seed * 1000003u + pairIndex;
+        MCTS::Puissance4* state = make_connect4_position(openingMoves, openingSeed);
+
+        GameResult result = {0.5f, 0, {0, 0}, {0.0, 0.0}, {false, false}};
+        Player* sides[2];
+        for(unsigned int side = 0; side < 2; ++side)
+            //each tree owns its root state: replay the same opening
+            sides[side] = new Player(players[side], make_connect4_position(openingMoves, openingSeed));
+        MCTS::seed_random(openingSeed * 2 + playerOfX);
+
+        while(not state->is_game_over()) {
+            const unsigned int side = (state->get_player_to_move() == 0) ? playerOfX : 1 - playerOfX;
+
+            const double start = thread_cpu_seconds();
+            const unsigned int moveIndex = sides[side]->choose_move();
+            result.cpuSeconds[side] += thread_cpu_seconds() - start;
+            result.moves[side] += 1;
+            result.plies += 1;
+
+            if(sides[side]->is_out_of_time()) {
+                result.lostOnTime[side] = true;
+                result.scoreA = (side == 0) ? 0.0f : 1.0f;
+                break;
+            }
+
+            sides[0]->play(moveIndex);
+            sides[1]->play(moveIndex);
+            MCTS::Puissance4* nextState = state->do_move(moveIndex);
+            delete state;
+            state = nextState;
+        }
+
+        //the score is the one of X
+        if(state->is_game_over()) {
+            const float scoreOfX = state->get_score();
+            result.scoreA = (playerOfX == 0) ? scoreOfX : 1.0f - scoreOfX;
+        }
+
+        delete sides[0];
+        delete sides[1];
+        delete state;
+        return result;
+    }
+
+    std::vector<GameResult> play_match(const PlayerSettings players[2], unsigned int games, unsigned int threads, unsigned int openingMoves, unsigned int seed,
+                                       const std::function<void (unsigned int)>& onGameFinished) {
+        std::vector<GameResult> results(games);
+        std::atomic<unsigned int> nextGame(0);
+        std::atomic<unsigned int> finishedGames(0);
+
+        std::vector<std::thread> workers;
+        threads = std::min(std::max(1u, threads), std::max(1u, games));
+        for(unsigned int t = 0; t < threads; ++t) {
+            workers.emplace_back([&]() {
+                unsigned int gameIndex;
+                while((gameIndex = nextGame++) < games) {
+                    results[gameIndex] = play_game(players, openingMoves, seed, gameIndex);
+                    const unsigned int finished = ++finishedGames;
+                    if(onGameFinished)
+                        onGameFinished(finished);
+                }
+            });
+        }
+        for(std::thread& worker : workers)
+            worker.join();
+        return results;
+    }
+
+    MatchScore get_match_score(const std::vector<GameResult>& results) {
+        MatchScore score = {0, 0, 0, 0.5, 0.0};
+        for(const GameResult& result : results) {
+            if(result.scoreA > 0.75f)
+                score.wins += 1;
+            else if(result.scoreA < 0.25f)
+                score.losses += 1;
+            else
+                score.draws += 1;
+        }
+        if(results.empty())
+            return score;
+
+        //score of A, and its standard error from the variance of the game results
+        const double games = results.size();
+        score.score = (score.wins + 0.5 * score.draws) / games;
+        const double variance = (score.wins * (1.0 - score.score) * (1.0 - score.score) + score.draws * (0.5 - score.score) * (0.5 - score.score) + score.losses * score.score * score.score) / games;
+        score.margin = 1.96 * std::sqrt(variance / games);
+        return score;
+    }
+
+    double elo_difference(double score) {
+        if(score <= 0.0)
+            return -std::numeric_limits<double>::infinity();
+        if(score >= 1.0)
+            return std::numeric_limits<double>::infinity();
+        return -400.0 * std::log10(1.0 / score - 1.0);
+    }
+
+}
@@ -0,0 +1,125 @@
+#ifndef MCTS_BENCHMARK_CONNECT4_MATCH_HPP
+#define MCTS_BENCHMARK_CONNECT4_MATCH_HPP
+
+#include "search_config.hpp"
+#include "time_manager.hpp"
+
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * \file    connect4_match.hpp
+ * \author  Baptiste Hudyma
+ * \version 1.0
+ * \date    11 mars 2021
+ *
+ * \brief   Connect 4 games between two MCTS configurations, played in parallel, shared by the match runner and the tuner
+ * \details Each pair of games starts from the same random opening, each configuration playing X once.
+ */
+
+namespace Benchmark {
+
+    enum class RolloutMode {
+        Random,     //random rollouts (search_best_move_until, run_iterations by chunks on a CPU time budget)
+        Heuristic   //batched Connect4Evaluator evaluation (search_best_move_batched)
+    };
+
+    /**
+     * \brief   Search settings of one side of a match
+     * \details The iteration budget is SearchConfig::iterationsPerMove. The time budget is measured in thread CPU time,
+     *          so that games played on more threads than cores stay fair.
+     */
+    struct PlayerSettings {
+        double moveMilliseconds = 0.0;      //thread CPU time per move, replaces the iterations when > 0
+        bool useGameClock = false;          //TimeManager on timeControl, replaces the other budgets
+        MCTS::TimeControl timeControl;
+        RolloutMode rollout = RolloutMode::Random;
+        MCTS::SearchConfig config;
+
+        PlayerSettings() {
+            //a Connect 4 game rarely lasts more than 20 moves of each player
+            timeControl.expectedMoves = 18;
+        }
+    };
+
+    struct GameResult {
+        float scoreA;                       //1 if A won, 0.5 for a draw, 0 if B won
+        unsigned int plies;
+        unsigned int moves[2];              //moves searched by A and B
+        double cpuSeconds[2];               //thread CPU time of those searches
+        bool lostOnTime[2];                 //the game clock of the side ran out, losing the game
+    };
+
+    /**
+     * \brief   Summary of the results of a match, for the side A
+     */
+    struct MatchScore {
+        unsigned int wins;
+        unsigned int draws;
+        unsigned int losses;
+        double score;                       //in [0, 1]
+        double margin;                      //95% confidence margin of the score
+    };
+
+    /**
+     * \return The CPU time of the calling thread, in seconds
+     */
+    double thread_cpu_seconds();
+
+    /**
+     * \brief   Set an option of a side of a match from its command line name: time-ms (thread CPU time), game-ms, increment-ms and
+     *          time-manager (adaptive or flat) for a game clock, rollout (random or heuristic), or any search option of MCTS::set_search_option
+     *
+     * \return  False if the option is unknown or its value is not valid
+     */
+    bool set_player_option(PlayerSettings& player, const std::string& name, const std::string& value);
+
+    /**
+     * \brief   Check that the player applies every option set: the early stop rules (early-stop, early-stop-window) need
+     *          the random rollouts, on an iteration budget or a game clock
+     *
+     * \return  The option that is not applied and why, empty if there is none
+     */
+    std::string get_unapplied_options(const PlayerSettings& player);
+
+    /**
+     * \brief   Write the usage of the options of set_player_option, one option per line
+     *
+     * \param[in] prefix    Prefix of the option names, after the dashes
+     * \param[in] defaults  Settings giving the default values shown
+     */
+    void show_player_options(std::ostream& stream, const std::string& prefix, const PlayerSettings& defaults);
+
+    /**
+     * \brief   Play one game of a match
+     *
+     * \param[in] players       Settings of A and B
+     * \param[in] openingMoves  Random moves before the players search, the same for both games of a pair
+     * \param[in] seed          Seed of the openings and searches
+     * \param[in] gameIndex     Index of the game, A plays X on the even games
+     */
+    GameResult play_game(const PlayerSettings players[2], unsigned int openingMoves, unsigned int seed, unsigned int gameIndex);
+
+    /**
+     * \brief   Play the games of a match on worker threads, each pulling the next game to play
+     *
+     * \param[in] threads         Worker threads, at most one per game
+     * \param[in] onGameFinished  If set, called with the count of finished games after each game, from the worker threads
+     *
+     * \return  The result of each game, by game index
+     */
+    std::vector<GameResult> play_match(const PlayerSettings players[2], unsigned int games, unsigned int threads, unsigned int openingMoves, unsigned int seed,
+                                       const std::function<void (unsigned int)>& onGameFinished = nullptr);
+
+    MatchScore get_match_score(const std::vector<GameResult>& results);
+
+    /**
+     * \return  The Elo difference giving this expected score, infinite for 0 and 1
+     */
+    double elo_difference(double score);
+
+}
+
+#endif
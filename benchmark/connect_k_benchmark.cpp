@@ -0,0 +1,90 @@
+#include "benchmarks.hpp"
+
+#include "connect_k.hpp"
+#include "MCTS.hpp"
+
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace Benchmark {
+
+    namespace {
+
+        /**
+         * \brief Play random games from the empty board, return the games per second
+         */
+        template<typename Game>
+        double random_games_per_second(unsigned int games) {
+            MCTS::seed_random(7);
+            Timer timer;
+            for(unsigned int game = 0; game < games; ++game) {
+                std::unique_ptr<MCTS::IGame_State> state(new Game());
+                while(not state->is_game_over())
+                    state.reset(state->do_move(MCTS::random_index(state->get_move_count())));
+            }
+            return games / timer.elapsed_seconds();
+        }
+
+        template<typename Game>
+        double search_iterations_per_second(unsigned int iterations) {
+            MCTS::seed_random(7);
+            MCTS::MCTS tree(new Game());
+            Timer timer;
+            tree.search_best_move(iterations);
+            return tree.get_last_search_stats().iterations / timer.elapsed_seconds();
+        }
+
+        template<typename Game>
+        void show_variant(const char* name, unsigned int games, unsigned int iterations) {
+            std::cout << std::left << std::setw(22) << name << std::right
+                << " | " << std::setw(11) << sizeof(typename Game::Board) * 8
+                << " | " << std::setw(12) << static_cast<unsigned int>(random_games_per_second<Game>(games))
+                << " | " << std::setw(12) << static_cast<unsigned int>(search_iterations_per_second<Game>(iterations)) << std::endl;
+        }
+
+        /**
+         * \brief Play the same random move indexes on Puissance4 and ConnectFour, return the number of games with different outcomes
+         */
+        unsigned int count_outcome_mismatches(unsigned int games) {
+            unsigned int mismatches = 0;
+            for(unsigned int game = 0; game < games; ++game) {
+                std::unique_ptr<MCTS::IGame_State> reference(new MCTS::Puissance4());
+                std::unique_ptr<MCTS::IGame_State> state(new MCTS::ConnectFour());
+                while(not reference->is_game_over() and not state->is_game_over()) {
+                    if(reference->get_move_count() != state->get_move_count())
+                        break;
+                    const unsigned int index = MCTS::random_index(state->get_move_count());
+                    reference.reset(reference->do_move(index));
+                    state.reset(state->do_move(index));
+                }
+                if(reference->is_game_over() != state->is_game_over() or reference->get_score() != state->get_score())
+                    mismatches += 1;
+            }
+            return mismatches;
+        }
+
+    }
+
+    int run_connect_k_benchmark(int argc, char** argv) {
+        const unsigned int games = get_argument(argc, argv, 1, 100000);
+        const unsigned int iterations = get_argument(argc, argv, 2, 100000);
+
+        std::cout << "Random games from the empty board (" << games << "), search from the empty board (" << iterations << " iterations)" << std::endl;
+        std::cout << "game                   | board bits  | games/s      | iterations/s" << std::endl;
+        std::cout << std::left << std::setw(22) << "Puissance4 (7x6, 4)" << std::right
+            << " | " << std::setw(11) << "-"
+            << " | " << std::setw(12) << static_cast<unsigned int>(random_games_per_second<MCTS::Puissance4>(games))
+            << " | " << std::setw(12) << static_cast<unsigned int>(search_iterations_per_second<MCTS::Puissance4>(iterations)) << std::endl;
+        show_variant<MCTS::ConnectK<4, 4, 3>>("ConnectK<4, 4, 3>", games, iterations);
+        show_variant<MCTS::ConnectFour>("ConnectK<7, 6, 4>", games, iterations);
+        show_variant<MCTS::ConnectK<8, 7, 4>>("ConnectK<8, 7, 4>", games, iterations);
+        show_variant<MCTS::ConnectK<9, 9, 5>>("ConnectK<9, 9, 5>", games, iterations);
+
+        std::cout << "Puissance4 and ConnectK<7, 6, 4> outcome mismatches on " << games / 10 << " random games: "
+            << count_outcome_mismatches(games / 10) << std::endl;
+        return 0;
+    }
+
+} /* Benchmark */
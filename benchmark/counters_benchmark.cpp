@@ -0,0 +1,183 @@
+#include "benchmarks.hpp"
+#include "perf_counters.hpp"
+
+#include "node.hpp"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+namespace Benchmark {
+
+    namespace {
+
+        enum SearchPhase {
+            Selection = 0,
+            Expansion,
+            Rollout,
+            Backpropagation,
+            ReadOverhead,       //two reads in a row, the cost included in each phase
+            SearchPhaseCount
+        };
+
+        const char* phaseNames[SearchPhaseCount] = {"selection", "expansion", "rollout", "backpropagation", "read overhead"};
+
+        /**
+         * \brief Sum the counters and time of each phase
+         */
+        class PhaseRecorder {
+            public:
+                PhaseRecorder(const PerfCounters& counters) : _counters(counters) {
+                    for(PerfValues& values : _totals)
+                        values.fill(0.0);
+                    _seconds.fill(0.0);
+                    for(std::array<unsigned int, PerfEventCount>& counts : _countedPhases)
+                        counts.fill(0);
+                    _lastRead = false;
+                }
+
+                void start() {
+                    _lastRead = _counters.read(_last);
+                    _lastTime = std::chrono::steady_clock::now();
+                }
+
+                /**
+                 * \brief End the running phase, and start the next one
+                 * \details The count of an event is only summed if its group ran on the PMU during the phase
+                 */
+                void end_phase(SearchPhase phase) {
+                    PerfSample sample;
+                    const bool isRead = _counters.read(sample);
+                    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+                    if(isRead and _lastRead) {
+                        PerfValues values;
+                        std::array<bool, PerfEventCount> counted;
+                        PerfCounters::get_difference(_last, sample, values, counted);
+                        for(int event = 0; event < PerfEventCount; ++event) {
+                            if(not counted[event])
+                                continue;
+                            _totals[phase][event] += values[event];
+                            _countedPhases[phase][event] += 1;
+                        }
+                    }
+                    _seconds[phase] += std::chrono::duration<double>(now - _lastTime).count();
+                    _last = sample;
+                    _lastRead = isRead;
+                    _lastTime = now;
+                }
+
+                const PerfValues& get_totals(SearchPhase phase) const { return _totals[phase]; }
+                double get_seconds(SearchPhase phase) const { return _seconds[phase]; }
+                //number of times the phase ran with this event counted
+                unsigned int get_counted_phases(SearchPhase phase, PerfEvent event) const { return _countedPhases[phase][event]; }
+
+            private:
+                const PerfCounters& _counters;
+                std::array<PerfValues, SearchPhaseCount> _totals;
+                std::array<double, SearchPhaseCount> _seconds;
+                std::array<std::array<unsigned int, PerfEventCount>, SearchPhaseCount> _countedPhases;
+                PerfSample _last;
+                bool _lastRead;
+                std::chrono::steady_clock::time_point _lastTime;
+        };
+
+        /**
+         * \brief One iteration of MCTS::run_iteration, split in phases (the descent of MCTS::get_UCT_leaf, then its expansion)
+         *
+         * \return False if no leaf could be expanded
+         */
+        bool run_recorded_iteration(MCTS::Node* root, const MCTS::SearchConfig& config, PhaseRecorder& recorder) {
+            recorder.start();
+            MCTS::Node* node = root;
+            while(not node->is_game_over() and not node->can_expand(config)) {
+                MCTS::Node* bestChild = node->get_best_child_UCT(config);
+                if(bestChild == nullptr)
+                    break;
+                node = bestChild;
+            }
+            recorder.end_phase(Selection);
+
+            MCTS::Node* leaf = node->is_game_over() ? nullptr : node->expand_children(config);
+            recorder.end_phase(Expansion);
+            if(leaf == nullptr)
+                return false;
+
+            const float reward = leaf->rollout();
+            recorder.end_phase(Rollout);
+
+            leaf->backpropagate(reward);
+            recorder.end_phase(Backpropagation);
+
+            recorder.end_phase(ReadOverhead);
+            return true;
+        }
+
+    }
+
+    int run_counters_benchmark(int argc, char** argv) {
+        const unsigned int treeIterations = get_argument(argc, argv, 1, 200000);
+        const unsigned int iterations = get_argument(argc, argv, 2, 100000);
+
+        PerfCounters counters;
+        if(not counters.is_available())
+            std::cout << "Hardware counters unavailable (" << counters.get_error() << "), reporting the time only" << std::endl;
+
+        const MCTS::SearchConfig config;
+        MCTS::Node root(make_connect4_position(0, 1));
+        MCTS::seed_random(1);
+        {
+            //grow the tree without recording
+            PhaseRecorder recorder(counters);
+            for(unsigned int i = 0; i < treeIterations and not root.is_closed(); ++i)
+                run_recorded_iteration(&root, config, recorder);
+        }
+
+        PhaseRecorder recorder(counters);
+        unsigned int recorded = 0;
+        for(unsigned int i = 0; i < iterations and not root.is_closed(); ++i)
+            recorded += run_recorded_iteration(&root, config, recorder) ? 1 : 0;
+
+        std::cout << "Connect 4, tree of " << treeIterations << " iterations, " << recorded << " recorded iterations, values per iteration" << std::endl;
+        std::cout << std::fixed << std::setprecision(1);
+        std::cout << std::left << std::setw(16) << "phase" << std::right << " | " << std::setw(9) << "ns";
+        for(int event = 0; event < PerfEventCount; ++event) {
+            if(counters.is_counted(static_cast<PerfEvent>(event)))
+                std::cout << " | " << std::setw(13) << PerfCounters::get_event_name(static_cast<PerfEvent>(event));
+        }
+        if(counters.is_counted(Cycles) and counters.is_counted(Instructions))
+            std::cout << " | " << std::setw(5) << "IPC";
+        std::cout << std::endl;
+
+        unsigned int uncountedMeasures = 0;
+        for(int phase = 0; phase < SearchPhaseCount; ++phase) {
+            const PerfValues& totals = recorder.get_totals(static_cast<SearchPhase>(phase));
+            std::cout << std::left << std::setw(16) << phaseNames[phase] << std::right
+                << " | " << std::setw(9) << 1e9 * recorder.get_seconds(static_cast<SearchPhase>(phase)) / recorded;
+            for(int event = 0; event < PerfEventCount; ++event) {
+                if(not counters.is_counted(static_cast<PerfEvent>(event)))
+                    continue;
+                //the counts are averaged over the runs of the phase where the event was counted only
+                const unsigned int countedPhases = recorder.get_counted_phases(static_cast<SearchPhase>(phase), static_cast<PerfEvent>(event));
+                uncountedMeasures += recorded - countedPhases;
+                if(countedPhases > 0)
+                    std::cout << " | " << std::setw(13) << totals[event] / countedPhases;
+                else
+                    std::cout << " | " << std::setw(13) << "not counted";
+            }
+            if(counters.is_counted(Cycles) and counters.is_counted(Instructions)) {
+                //cycles and instructions are in the same group, counted together
+                const unsigned int countedPhases = recorder.get_counted_phases(static_cast<SearchPhase>(phase), Cycles);
+                if(countedPhases > 0 and totals[Cycles] > 0)
+                    std::cout << " | " << std::setw(5) << std::setprecision(2) << totals[Instructions] / totals[Cycles] << std::setprecision(1);
+                else
+                    std::cout << " | " << std::setw(5) << "-";
+            }
+            std::cout << std::endl;
+        }
+        if(uncountedMeasures > 0)
+            std::cout << uncountedMeasures << " event measures of a phase were not counted (the group of the event did not run on the PMU during the phase:"
+                      << " counters taken by the NMI watchdog or another profiler, or multiplexed out) and are left out of the averages" << std::endl;
+        return 0;
+    }
+
+} /* Benchmark */
@@ -0,0 +1,80 @@
+#include "benchmarks.hpp"
+
+#include "MCTS.hpp"
+
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace Benchmark {
+
+    namespace {
+
+        struct StopResult {
+            unsigned int bestMove;
+            unsigned int iterations;
+            double seconds;
+        };
+
+        StopResult search_position(unsigned int position, const MCTS::SearchConfig& config, unsigned int iterations) {
+            //from the opening to the middle game, where many moves are forced
+            MCTS::MCTS tree(make_connect4_position(position % 16, position + 1), config);
+            MCTS::seed_random(position);
+
+            Timer timer;
+            StopResult result;
+            result.bestMove = tree.search_best_move(iterations);
+            result.seconds = timer.elapsed_seconds();
+            result.iterations = tree.get_last_search_stats().iterations;
+            return result;
+        }
+
+    }
+
+    int run_early_stop_benchmark(int argc, char** argv) {
+        const unsigned int iterations = get_argument(argc, argv, 1, 50000);
+        const unsigned int positions = get_argument(argc, argv, 2, 16);
+        const unsigned int window = get_argument(argc, argv, 3, iterations / 4);
+
+        struct Mode {
+            const char* name;
+            MCTS::SearchConfig config;
+        };
+        std::vector<Mode> modes(3);
+        modes[0].name = "full budget";
+        modes[1].name = "visit bound";
+        modes[1].config.useEarlyStop = true;
+        modes[2].name = "visit bound + window";
+        modes[2].config.useEarlyStop = true;
+        modes[2].config.earlyStopStableWindow = window;
+
+        std::cout << "Connect 4, " << positions << " positions, budget of " << iterations << " iterations, stable window " << window << std::endl;
+        std::cout << std::fixed << std::setprecision(3);
+        std::cout << "mode                 | mean iterations | saved  | mean latency | same move as full budget" << std::endl;
+
+        std::vector<unsigned int> referenceMoves;
+        double referenceSeconds = 0;
+        for(const Mode& mode : modes) {
+            double iterationSum = 0, seconds = 0;
+            unsigned int sameMove = 0;
+            for(unsigned int position = 0; position < positions; ++position) {
+                const StopResult result = search_position(position, mode.config, iterations);
+                if(referenceMoves.size() < positions)
+                    referenceMoves.push_back(result.bestMove);
+                iterationSum += result.iterations;
+                seconds += result.seconds;
+                sameMove += (result.bestMove == referenceMoves[position]) ? 1 : 0;
+            }
+            if(referenceSeconds == 0)
+                referenceSeconds = seconds;
+
+            std::cout << std::left << std::setw(20) << mode.name << std::right
+                << " | " << std::setw(15) << static_cast<unsigned int>(iterationSum / positions)
+                << " | " << std::setw(5) << std::setprecision(1) << 100.0 * (1.0 - iterationSum / (positions * iterations)) << "%"
+                << " | " << std::setw(11) << std::setprecision(3) << seconds / positions << "s"
+                << " | " << sameMove << "/" << positions << std::endl;
+        }
+        return 0;
+    }
+
+} /* Benchmark */
@@ -0,0 +1,81 @@
+#include "benchmarks.hpp"
+
+#include "MCTS.hpp"
+
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace Benchmark {
+
+    namespace {
+
+        //random moves of the first position, the next ones going up to 11 moves
+        const unsigned int openingMoves = 6;
+
+        struct ExpansionResult {
+            double seconds;
+            double nodeCount;
+            double treeBytes;
+            unsigned int agreements;    //positions where the chosen move is the reference move
+        };
+
+        unsigned int search_position(unsigned int position, const MCTS::SearchConfig& config, unsigned int iterations, ExpansionResult& result) {
+            MCTS::MCTS tree(make_connect4_position(openingMoves + position % 6, position + 1), config);
+            MCTS::seed_random(position + 1);
+
+            Timer timer;
+            tree.run_iterations(iterations);
+            const MCTS::Node* best = tree.get_best_move();
+            result.seconds += timer.elapsed_seconds();
+
+            const MCTS::TreeStats stats = tree.tree_stats();
+            result.nodeCount += stats.nodeCount;
+            result.treeBytes += stats.get_total_bytes();
+            return (best == nullptr) ? 0 : best->get_move_index();
+        }
+
+    }
+
+    int run_expanding_rollout_benchmark(int argc, char** argv) {
+        const unsigned int iterations = get_argument(argc, argv, 1, 10000);
+        const unsigned int positions = get_argument(argc, argv, 2, 20);
+        const unsigned int nodeBudget = get_argument(argc, argv, 3, 4 * iterations);
+        const unsigned int referenceIterations = 10 * iterations;
+
+        //reference moves: plain search with ten times the budget
+        std::vector<unsigned int> referenceMoves(positions);
+        ExpansionResult reference = {0.0, 0.0, 0.0, 0};
+        for(unsigned int position = 0; position < positions; ++position)
+            referenceMoves[position] = search_position(position, MCTS::SearchConfig(), referenceIterations, reference);
+
+        struct Mode {
+            unsigned int expansions;
+            unsigned int budget;
+        };
+        const std::vector<Mode> modes = {{0, 0}, {1, 0}, {2, 0}, {4, 0}, {8, 0}, {16, 0}, {42, 0}, {4, nodeBudget}, {42, nodeBudget}};
+
+        std::cout << "Connect 4, " << positions << " positions, " << iterations << " iterations, reference moves from " << referenceIterations << " plain iterations" << std::endl;
+        std::cout << std::fixed << std::setprecision(2);
+        std::cout << "K   | node budget | iterations/s | nodes    | tree MB  | reference move" << std::endl;
+        for(const Mode& mode : modes) {
+            MCTS::SearchConfig config;
+            config.rolloutExpansionNodes = mode.expansions;
+            config.rolloutExpansionNodeBudget = mode.budget;
+
+            ExpansionResult result = {0.0, 0.0, 0.0, 0};
+            for(unsigned int position = 0; position < positions; ++position) {
+                if(search_position(position, config, iterations, result) == referenceMoves[position])
+                    result.agreements += 1;
+            }
+            std::cout << std::setw(3) << mode.expansions
+                << " | " << std::setw(11) << mode.budget
+                << " | " << std::setw(12) << static_cast<unsigned int>(iterations * positions / result.seconds)
+                << " | " << std::setw(8) << static_cast<unsigned int>(result.nodeCount / positions)
+                << " | " << std::setw(8) << result.treeBytes / positions / 1e6
+                << " | " << std::setw(13) << 100.0 * result.agreements / positions << "%" << std::endl;
+        }
+        return 0;
+    }
+
+} /* Benchmark */
@@ -0,0 +1,59 @@
+#include "benchmarks.hpp"
+
+#include "MCTS.hpp"
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace Benchmark {
+
+    int run_export_benchmark(int argc, char** argv) {
+        const unsigned int iterations = get_argument(argc, argv, 1, 1000000);
+        const std::string directory = (argc > 2) ? argv[2] : "/tmp";
+
+        MCTS::MCTS tree(make_connect4_position(0, 1));
+        MCTS::seed_random(1);
+        tree.run_iterations(iterations);
+
+        std::cout << "Connect 4 tree of " << iterations << " iterations, files in " << directory << std::endl;
+        std::cout << std::fixed << std::setprecision(3);
+        std::cout << "export                         | nodes   | seconds | nodes/s" << std::endl;
+        auto show_line = [](const char* name, size_t nodes, double seconds) {
+            std::cout << std::left << std::setw(30) << name << std::right
+                << " | " << std::setw(7) << nodes
+                << " | " << std::setw(7) << seconds
+                << " | " << std::setw(7) << static_cast<unsigned long long>(nodes / seconds) << std::endl;
+        };
+
+        {
+            //the previous way: show_tree to std::cout, redirected to a file
+            std::ofstream file(directory + "/mcts_tree.txt");
+            std::streambuf* coutBuffer = std::cout.rdbuf(file.rdbuf());
+            Timer timer;
+            tree.show_tree(1000);
+            const double seconds = timer.elapsed_seconds();
+            std::cout.rdbuf(coutBuffer);
+            show_line("show_tree (text)", tree.tree_stats().nodeCount, seconds);
+        }
+
+        Timer jsonTimer;
+        const size_t jsonNodes = tree.export_tree(directory + "/mcts_tree.json", MCTS::ExportFormat::Json);
+        show_line("JSON", jsonNodes, jsonTimer.elapsed_seconds());
+
+        Timer dotTimer;
+        const size_t dotNodes = tree.export_tree(directory + "/mcts_tree.dot", MCTS::ExportFormat::Dot);
+        show_line("DOT", dotNodes, dotTimer.elapsed_seconds());
+
+        MCTS::ExportFilter filter;
+        filter.minVisits = 10;
+        filter.topChildren = 3;
+        filter.maxDepth = 8;
+        Timer filteredTimer;
+        const size_t filteredNodes = tree.export_tree(directory + "/mcts_tree_filtered.dot", MCTS::ExportFormat::Dot, filter);
+        show_line("DOT, 10 visits, top 3, depth 8", filteredNodes, filteredTimer.elapsed_seconds());
+        return 0;
+    }
+
+} /* Benchmark */
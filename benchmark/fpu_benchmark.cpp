@@ -0,0 +1,113 @@
+#include "benchmarks.hpp"
+#include "wide_game.hpp"
+
+#include "MCTS.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace Benchmark {
+
+    namespace {
+
+        const unsigned int branching = 250;
+        const unsigned int gameDepth = 30;
+
+        struct UrgencyResult {
+            double rootChildren;        //expanded root moves
+            double singleVisitShare;    //share of the nodes visited only once: iterations spent on a first visit without a revisit
+            double maxDepth;
+            double seconds;
+            double bestMoveValue;       //value of the chosen root move
+            double bestMoveRank;        //rank of the chosen root move among the root moves, 1 for the best
+        };
+
+        UrgencyResult measure_urgency(unsigned int seed, const MCTS::SearchConfig& config, unsigned int iterations) {
+            UrgencyResult result = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+            WideGame* root = new WideGame(branching, gameDepth, seed);
+
+            MCTS::seed_random(seed);
+            MCTS::MCTS tree(root, config);
+
+            Timer timer;
+            tree.run_iterations(iterations);
+            const MCTS::Node* best = tree.get_best_move();
+            result.seconds = timer.elapsed_seconds();
+
+            const unsigned int bestMove = (best == nullptr) ? 0 : best->get_move_index();
+            result.bestMoveValue = root->get_move_value(bestMove);
+            for(unsigned int move = 0; move < branching; ++move)
+                result.bestMoveRank += (root->get_move_value(move) >= result.bestMoveValue) ? 1 : 0;
+
+            const TreeShape shape = measure_tree_shape(tree.get_root(), sizeof(WideGame));
+            result.rootChildren = tree.get_root()->get_children().size();
+            result.maxDepth = shape.maxDepth;
+
+            unsigned int singleVisits = 0;
+            std::vector<const MCTS::Node*> toVisit(1, tree.get_root());
+            while(not toVisit.empty()) {
+                const MCTS::Node* node = toVisit.back();
+                toVisit.pop_back();
+                singleVisits += (node->get_visit_count() <= 1) ? 1 : 0;
+                toVisit.insert(toVisit.end(), node->get_children().begin(), node->get_children().end());
+            }
+            result.singleVisitShare = static_cast<double>(singleVisits) / shape.nodeCount;
+            return result;
+        }
+
+    }
+
+    int run_fpu_benchmark(int argc, char** argv) {
+        const unsigned int iterations = get_argument(argc, argv, 1, 20000);
+        const unsigned int games = get_argument(argc, argv, 2, 5);
+
+        struct Mode {
+            const char* name;
+            MCTS::SearchConfig config;
+        };
+        std::vector<Mode> modes(6);
+        modes[0].name = "UCT";
+        modes[1].name = "UCT + FPU 1";
+        modes[1].config.useFirstPlayUrgency = true;
+        modes[2].name = "UCT + FPU 1.5";
+        modes[2].config = modes[1].config;
+        modes[2].config.firstPlayUrgency = 1.5f;
+        modes[3].name = "PUCT";
+        modes[3].config.usePuct = true;
+        modes[3].config.useMovePriorOrder = true;
+        modes[4].name = "PUCT + FPU 1";
+        modes[4].config = modes[3].config;
+        modes[4].config.useFirstPlayUrgency = true;
+        modes[5].name = "PUCT + FPU 0.5";
+        modes[5].config = modes[4].config;
+        modes[5].config.firstPlayUrgency = 0.5f;
+
+        std::cout << "Wide synthetic game (" << branching << " moves, " << gameDepth << " plies), "
+            << games << " games, " << iterations << " iterations" << std::endl;
+        std::cout << std::fixed << std::setprecision(2);
+        std::cout << "mode             | root children | single visits | max depth | iterations/s | root move value | root move rank" << std::endl;
+        for(const Mode& mode : modes) {
+            UrgencyResult sum = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+            for(unsigned int game = 0; game < games; ++game) {
+                const UrgencyResult result = measure_urgency(game + 1, mode.config, iterations);
+                sum.rootChildren += result.rootChildren;
+                sum.singleVisitShare += result.singleVisitShare;
+                sum.maxDepth += result.maxDepth;
+                sum.seconds += result.seconds;
+                sum.bestMoveValue += result.bestMoveValue;
+                sum.bestMoveRank += result.bestMoveRank;
+            }
+            std::cout << std::left << std::setw(16) << mode.name << std::right
+                << " | " << std::setw(13) << sum.rootChildren / games
+                << " | " << std::setw(12) << 100.0 * sum.singleVisitShare / games << "%"
+                << " | " << std::setw(9) << sum.maxDepth / games
+                << " | " << std::setw(12) << static_cast<unsigned int>(iterations * games / sum.seconds)
+                << " | " << std::setw(15) << sum.bestMoveValue / games
+                << " | " << std::setw(14) << sum.bestMoveRank / games << std::endl;
+        }
+        return 0;
+    }
+
+} /* Benchmark */
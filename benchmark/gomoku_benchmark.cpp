@@ -0,0 +1,61 @@
+#include "benchmarks.hpp"
+
+#include "gomoku.hpp"
+#include "MCTS.hpp"
+
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace Benchmark {
+
+    int run_gomoku_benchmark(int argc, char** argv) {
+        const unsigned int iterations = get_argument(argc, argv, 1, 5000);
+        const unsigned int openingMoves = get_argument(argc, argv, 2, 4);
+
+        struct Mode {
+            const char* name;
+            MCTS::SearchConfig config;
+        };
+        std::vector<Mode> modes(3);
+        modes[0].name = "full expansion";
+        modes[1].name = "widening";
+        modes[1].config.useProgressiveWidening = true;
+        modes[2].name = "widening + prior";
+        modes[2].config.useProgressiveWidening = true;
+        modes[2].config.useMovePriorOrder = true;
+
+        std::cout << "15x15 Gomoku after " << openingMoves << " random moves, " << iterations << " iterations" << std::endl;
+        std::cout << std::fixed << std::setprecision(2);
+        std::cout << "mode             | iterations/s | nodes   | root children | mean children | max depth | tree MB" << std::endl;
+        for(const Mode& mode : modes) {
+            MCTS::seed_random(3);
+            MCTS::Gomoku* state = new MCTS::Gomoku();
+            for(unsigned int i = 0; i < openingMoves; ++i) {
+                //random empty cell around the center
+                unsigned int x = 0, y = 0;
+                do {
+                    x = MCTS::Gomoku::boardSize / 2 - 2 + MCTS::random_index(5);
+                    y = MCTS::Gomoku::boardSize / 2 - 2 + MCTS::random_index(5);
+                } while(state->get_move_index(x, y) >= state->get_move_count());
+                state->play(x, y);
+            }
+
+            MCTS::MCTS tree(state, mode.config);
+            Timer timer;
+            tree.search_best_move(iterations);
+            const double seconds = timer.elapsed_seconds();
+
+            const TreeShape shape = measure_tree_shape(tree.get_root(), sizeof(MCTS::Gomoku));
+            std::cout << std::left << std::setw(16) << mode.name << std::right
+                << " | " << std::setw(12) << static_cast<unsigned int>(tree.get_last_search_stats().iterations / seconds)
+                << " | " << std::setw(7) << shape.nodeCount
+                << " | " << std::setw(13) << tree.get_root()->get_children().size()
+                << " | " << std::setw(13) << shape.meanChildren
+                << " | " << std::setw(9) << shape.maxDepth
+                << " | " << std::setw(7) << shape.treeBytes / 1e6 << std::endl;
+        }
+        return 0;
+    }
+
+} /* Benchmark */
@@ -0,0 +1,68 @@
+#include "benchmarks.hpp"
+
+#include "MCTS.hpp"
+#include "connect4_evaluator.hpp"
+
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace Benchmark {
+
+    namespace {
+
+        /**
+         * \brief Evaluator of negligible cost, leaving the descents as the main cost of the search
+         */
+        class DrawEvaluator :
+            public MCTS::ILeaf_Evaluator
+        {
+            public:
+                virtual void evaluate(const std::vector<const MCTS::IGame_State*>& states, std::vector<float>& values, std::vector<std::vector<float>>* priors) {
+                    values.assign(states.size(), 0.5f);
+                }
+        };
+
+    }
+
+    int run_interleaved_benchmark(int argc, char** argv) {
+        const unsigned int treeNodes = get_argument(argc, argv, 1, 1000000);
+        const unsigned int iterations = get_argument(argc, argv, 2, 100000);
+        const unsigned int batchSize = get_argument(argc, argv, 3, 16);
+
+        MCTS::Connect4Evaluator heuristic;
+        DrawEvaluator draw;
+
+        std::cout << "Connect 4, batches of " << batchSize << ", " << iterations << " iterations on a tree of " << treeNodes << " nodes built with the heuristic" << std::endl;
+        std::cout << "descents       | draw evaluator iterations/s | heuristic iterations/s" << std::endl;
+
+        for(bool interleave : {false, true}) {
+            MCTS::SearchConfig config;
+            config.evaluationBatchSize = batchSize;
+
+            //same tree for both modes, built with the plain descents
+            MCTS::MCTS tree(make_connect4_position(0, 1), config);
+            MCTS::seed_random(1);
+            tree.search_best_move_batched(treeNodes, heuristic);
+
+            config.interleaveDescents = interleave;
+            tree.set_config(config);
+
+            Timer drawTimer;
+            tree.search_best_move_batched(iterations, draw);
+            const double drawSeconds = drawTimer.elapsed_seconds();
+            const unsigned int drawIterations = tree.get_last_search_stats().iterations;
+
+            Timer heuristicTimer;
+            tree.search_best_move_batched(iterations, heuristic);
+            const double heuristicSeconds = heuristicTimer.elapsed_seconds();
+            const unsigned int heuristicIterations = tree.get_last_search_stats().iterations;
+
+            std::cout << std::left << std::setw(14) << (interleave ? "interleaved" : "plain") << std::right
+                << " | " << std::setw(27) << static_cast<unsigned int>(drawIterations / drawSeconds)
+                << " | " << std::setw(22) << static_cast<unsigned int>(heuristicIterations / heuristicSeconds) << std::endl;
+        }
+        return 0;
+    }
+
+} /* Benchmark */
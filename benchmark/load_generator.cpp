@@ -0,0 +1,108 @@
+#include "benchmarks.hpp"
+
+#include "random.hpp"
+#include "search_scheduler.hpp"
+
+#include <atomic>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+/**
+ * \file    load_generator.cpp
+ * \author  Baptiste Hudyma
+ * \version 1.0
+ * \date    11 mars 2021
+ *
+ * \brief   Simulate many concurrent Connect 4 sessions searching on one SearchScheduler
+ * \details Each session asks for a move, plays it, answers with a random opponent move and asks again until the game ends.
+ */
+
+namespace {
+
+    struct Session {
+        unsigned int searches = 0;
+        unsigned int remainingSearches = 0;
+        double latencySum = 0.0;
+        double maxLatency = 0.0;
+    };
+
+    struct LoadSettings {
+        unsigned int iterations;        //per search
+        unsigned int searchesPerSession;
+    };
+
+    std::atomic<unsigned int> finishedSessions(0);
+
+    void request_move(MCTS::SearchScheduler& scheduler, const LoadSettings& settings, Session& session, MCTS::IGame_State* state) {
+        scheduler.submit(state, settings.iterations, [&scheduler, &settings, &session](const MCTS::SearchResult& result) {
+            session.searches += 1;
+            session.remainingSearches -= 1;
+            session.latencySum += result.latencySeconds;
+            session.maxLatency = std::max(session.maxLatency, result.latencySeconds);
+
+            MCTS::IGame_State* afterMove = result.state->do_move(result.bestMove);
+            if(afterMove->is_game_over() or session.remainingSearches == 0) {
+                delete afterMove;
+                finishedSessions++;
+                return;
+            }
+
+            //the opponent answers at random
+            MCTS::IGame_State* afterReply = afterMove->do_move(MCTS::random_index(afterMove->get_move_count()));
+            delete afterMove;
+            if(afterReply->is_game_over()) {
+                delete afterReply;
+                finishedSessions++;
+                return;
+            }
+            request_move(scheduler, settings, session, afterReply);
+        });
+    }
+
+}
+
+
+
+int main(int argc, char** argv) {
+    if(argc > 1 and std::string(argv[1]) == "--help") {
+        std::cout << "Usage: " << argv[0] << " [sessions] [iterations per search] [searches per session] [threads] [slice iterations]" << std::endl;
+        return 0;
+    }
+    const unsigned int sessionCount = Benchmark::get_argument(argc, argv, 1, 64);
+    LoadSettings settings;
+    settings.iterations = Benchmark::get_argument(argc, argv, 2, 5000);
+    settings.searchesPerSession = Benchmark::get_argument(argc, argv, 3, 8);
+    const unsigned int threads = Benchmark::get_argument(argc, argv, 4, 0);
+    const unsigned int slice = Benchmark::get_argument(argc, argv, 5, 512);
+
+    std::vector<Session> sessions(sessionCount);
+    MCTS::SearchScheduler scheduler(threads, slice);
+    std::cout << sessionCount << " sessions, " << settings.searchesPerSession << " searches of " << settings.iterations
+        << " iterations each, " << scheduler.get_thread_count() << " threads, slices of " << slice << " iterations" << std::endl;
+
+    for(unsigned int i = 0; i < sessionCount; ++i) {
+        sessions[i].remainingSearches = settings.searchesPerSession;
+        request_move(scheduler, settings, sessions[i], Benchmark::make_connect4_position(i % 5, i + 1));
+    }
+    scheduler.wait_all();
+
+    const MCTS::SchedulerStats stats = scheduler.get_stats();
+    double worstSessionMean = 0.0;
+    double worstLatency = 0.0;
+    for(const Session& session : sessions) {
+        if(session.searches > 0)
+            worstSessionMean = std::max(worstSessionMean, session.latencySum / session.searches);
+        worstLatency = std::max(worstLatency, session.maxLatency);
+    }
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "sessions finished     : " << finishedSessions << "/" << sessionCount << std::endl;
+    std::cout << "searches              : " << stats.completedJobs << std::endl;
+    std::cout << "throughput            : " << static_cast<unsigned long long>(stats.iterationsPerSecond) << " iterations/s, "
+        << stats.completedJobs / stats.elapsedSeconds << " searches/s" << std::endl;
+    std::cout << "search latency        : mean " << stats.meanLatencySeconds << "s, p50 " << stats.p50LatencySeconds
+        << "s, p99 " << stats.p99LatencySeconds << "s, max " << worstLatency << "s" << std::endl;
+    std::cout << "worst session mean    : " << worstSessionMean << "s" << std::endl;
+    return 0;
+}
@@ -0,0 +1,176 @@
+#include "benchmarks.hpp"
+#include "connect4_match.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * \file    match_runner.cpp
+ * \author  Baptiste Hudyma
+ * \version 1.0
+ * \date    11 mars 2021
+ *
+ * \brief   Play Connect 4 matches between two MCTS configurations, to measure the playing strength at a given compute cost
+ * \details The games run in parallel, one per worker thread. Each pair of games starts from the same random opening, each
+ *          configuration playing X once. The runner reports the score of A, the Elo difference with its 95% confidence bounds
+ *          and the thread CPU time spent per move by each configuration.
+ */
+
+namespace {
+
+    struct MatchSettings {
+        unsigned int games = 1000;
+        unsigned int threads = 0;
+        unsigned int openingMoves = 2;      //random moves shared by each pair of games
+        unsigned int seed = 1;
+        Benchmark::PlayerSettings players[2];
+    };
+
+    void show_player(const char* name, const Benchmark::PlayerSettings& player) {
+        std::cout << name << ": ";
+        if(player.useGameClock)
+            std::cout << player.timeControl.gameMilliseconds << " + " << player.timeControl.incrementMilliseconds << " ms "
+                      << (player.timeControl.adaptive ? "adaptive" : "flat") << " game clock";
+        else if(player.moveMilliseconds > 0.0)
+            std::cout << player.moveMilliseconds << " ms";
+        else
+            std::cout << player.config.iterationsPerMove << " iterations";
+        std::cout << (player.useGameClock ? ", " : " per move, ") << ((player.rollout == Benchmark::RolloutMode::Heuristic) ? "heuristic evaluation" : "random rollouts");
+        const std::string options = MCTS::to_search_options(player.config);
+        if(not options.empty())
+            std::cout << ", " << options;
+        std::cout << std::endl;
+    }
+
+    void show_usage(const char* program, const MatchSettings& defaults) {
+        std::cout << "Usage: " << program << " [options]" << std::endl
+                  << "  --games N            games to play, by pairs with swapped colors (1000)" << std::endl
+                  << "  --threads N          games played in parallel, 0 for one per hardware thread (0)" << std::endl
+                  << "  --opening N          random moves opening each pair of games (2)" << std::endl
+                  << "  --seed N             seed of the openings and searches (1)" << std::endl
+                  << "Options of the configuration A, --b-... for B:" << std::endl;
+        Benchmark::show_player_options(std::cout, "a-", defaults.players[0]);
+    }
+
+    /**
+     * \brief Parse the command line in settings
+     *
+     * \return False if an option is unknown or misses its value
+     */
+    bool parse_arguments(int argc, char** argv, MatchSettings& settings) {
+        for(int i = 1; i < argc; ++i) {
+            std::string option = argv[i];
+            Benchmark::PlayerSettings* player = nullptr;
+            if(option.rfind("--a-", 0) == 0 or option.rfind("--b-", 0) == 0) {
+                player = &settings.players[(option[2] == 'a') ? 0 : 1];
+                option = "--" + option.substr(4);
+            }
+            if(option.rfind("--", 0) != 0)
+                return false;
+
+            //flags
+            if(player != nullptr and MCTS::is_search_flag(option.substr(2))) {
+                MCTS::set_search_option(player->config, option.substr(2));
+                continue;
+            }
+
+            if(i + 1 >= argc)
+                return false;
+            const std::string value = argv[++i];
+            if(player == nullptr) {
+                if(option == "--games")
+                    settings.games = std::stoul(value);
+                else if(option == "--threads")
+                    settings.threads = std::stoul(value);
+                else if(option == "--opening")
+                    settings.openingMoves = std::stoul(value);
+                else if(option == "--seed")
+                    settings.seed = std::stoul(value);
+                else
+                    return false;
+            }
+            else if(not Benchmark::set_player_option(*player, option.substr(2), value)) {
+                return false;
+            }
+        }
+
+        //the budget and rollout options may come after the search options
+        for(unsigned int side = 0; side < 2; ++side) {
+            const std::string unapplied = Benchmark::get_unapplied_options(settings.players[side]);
+            if(not unapplied.empty()) {
+                std::cerr << (side == 0 ? "A: " : "B: ") << unapplied << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+
+}
+
+
+
+int main(int argc, char** argv) {
+    MatchSettings settings;
+    settings.players[0].config.iterationsPerMove = 5000;
+    settings.players[1].config.iterationsPerMove = 5000;
+    const MatchSettings defaults = settings;
+    if(not parse_arguments(argc, argv, settings)) {
+        show_usage(argv[0], defaults);
+        return 1;
+    }
+    if(settings.threads == 0)
+        settings.threads = std::max(1u, std::thread::hardware_concurrency());
+    settings.threads = std::min(settings.threads, std::max(1u, settings.games));
+
+    std::cout << settings.games << " Connect 4 games on " << settings.threads << " threads, " << settings.openingMoves << " opening moves" << std::endl;
+    show_player("A", settings.players[0]);
+    show_player("B", settings.players[1]);
+
+    std::mutex outputMutex;
+    const unsigned int reportInterval = std::max(1u, settings.games / 10);
+
+    Benchmark::Timer timer;
+    const std::vector<Benchmark::GameResult> results = Benchmark::play_match(settings.players, settings.games, settings.threads, settings.openingMoves, settings.seed,
+        [&](unsigned int finished) {
+            if(finished % reportInterval == 0) {
+                std::lock_guard<std::mutex> lock(outputMutex);
+                std::cout << "  " << finished << "/" << settings.games << " games, " << std::fixed << std::setprecision(1) << timer.elapsed_seconds() << " s" << std::endl;
+            }
+        });
+    const double elapsed = timer.elapsed_seconds();
+
+    unsigned long long plies = 0;
+    unsigned long long moves[2] = {0, 0};
+    double cpuSeconds[2] = {0.0, 0.0};
+    unsigned int lostOnTime[2] = {0, 0};
+    for(const Benchmark::GameResult& result : results) {
+        plies += result.plies;
+        for(unsigned int side = 0; side < 2; ++side) {
+            moves[side] += result.moves[side];
+            cpuSeconds[side] += result.cpuSeconds[side];
+            lostOnTime[side] += result.lostOnTime[side] ? 1 : 0;
+        }
+    }
+    const Benchmark::MatchScore score = Benchmark::get_match_score(results);
+    const double games = std::max(1u, settings.games);
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << std::endl << "A: " << score.wins << " wins, " << score.draws << " draws, " << score.losses << " losses, mean game length " << plies / games << " plies, " << elapsed << " s" << std::endl;
+    std::cout << "Score of A: " << std::setprecision(2) << 100.0 * score.score << "% +- " << 100.0 * score.margin << "% (95%)" << std::endl;
+    std::cout << std::setprecision(1) << "Elo difference A - B: " << Benchmark::elo_difference(score.score)
+              << " [" << Benchmark::elo_difference(score.score - score.margin) << ", " << Benchmark::elo_difference(score.score + score.margin) << "]" << std::endl;
+    std::cout << std::setprecision(3);
+    for(unsigned int side = 0; side < 2; ++side) {
+        const double movesPlayed = std::max(1ull, moves[side]);
+        std::cout << ((side == 0) ? "A" : "B") << ": " << 1000.0 * cpuSeconds[side] / movesPlayed << " ms CPU per move over " << moves[side] << " moves";
+        if(settings.players[side].useGameClock)
+            std::cout << ", " << 1000.0 * cpuSeconds[side] / games << " ms CPU per game, " << lostOnTime[side] << " games lost on time";
+        std::cout << std::endl;
+    }
+    return 0;
+}
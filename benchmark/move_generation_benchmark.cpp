@@ -0,0 +1,43 @@
+#include "benchmarks.hpp"
+
+#include "tictactoe.hpp"
+
+#include <iomanip>
+#include <iostream>
+#include <memory>
+
+namespace Benchmark {
+
+    namespace {
+
+        /**
+         * \brief Play random games from the empty board, return the do_move calls per second
+         */
+        template<typename Game>
+        double do_moves_per_second(unsigned int games) {
+            MCTS::seed_random(11);
+            unsigned long long moves = 0;
+            Timer timer;
+            for(unsigned int game = 0; game < games; ++game) {
+                std::unique_ptr<MCTS::IGame_State> state(new Game());
+                while(not state->is_game_over()) {
+                    state.reset(state->do_move(MCTS::random_index(state->get_move_count())));
+                    moves += 1;
+                }
+            }
+            return moves / timer.elapsed_seconds();
+        }
+
+    }
+
+    int run_move_generation_benchmark(int argc, char** argv) {
+        const unsigned int games = get_argument(argc, argv, 1, 200000);
+
+        std::cout << std::fixed << std::setprecision(0);
+        std::cout << "Random games from the empty board (" << games << ")" << std::endl;
+        std::cout << "Puissance4 : " << do_moves_per_second<MCTS::Puissance4>(games) << " do_move/s, " << sizeof(MCTS::Puissance4) << " bytes per state" << std::endl;
+        std::cout << "TicTacToe  : " << do_moves_per_second<MCTS::Game_State>(games) << " do_move/s, " << sizeof(MCTS::Game_State) << " bytes per state" << std::endl;
+        return 0;
+    }
+
+} /* Benchmark */
@@ -0,0 +1,73 @@
+#include "benchmarks.hpp"
+
+#include "MCTS.hpp"
+#include "root_parallel_search.hpp"
+
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace Benchmark {
+
+    int run_multiprocess_benchmark(int argc, char** argv) {
+        const unsigned int iterations = get_argument(argc, argv, 1, 20000);
+        const unsigned int positions = get_argument(argc, argv, 2, 8);
+        const unsigned int maximumWorkers = get_argument(argc, argv, 3, 4);
+
+        //reference moves: a single tree with the iterations of every worker
+        std::vector<unsigned int> referenceMoves;
+        for(unsigned int position = 0; position < positions; ++position) {
+            MCTS::MCTS tree(make_connect4_position(position % 16, position + 1));
+            MCTS::seed_random(position);
+            referenceMoves.push_back(tree.search_best_move(iterations * maximumWorkers));
+        }
+
+        struct Mode {
+            unsigned int workers;
+            bool useEarlyStop;
+        };
+        std::vector<Mode> modes;
+        for(unsigned int workers = 1; workers <= maximumWorkers; workers *= 2) {
+            modes.push_back({workers, false});
+        }
+        modes.push_back({maximumWorkers, true});
+
+        std::cout << "Connect 4, " << positions << " positions, " << iterations << " iterations per worker, " << std::thread::hardware_concurrency()
+            << " hardware threads, reference of " << iterations * maximumWorkers << " iterations on one tree" << std::endl;
+        std::cout << std::fixed << std::setprecision(3);
+        std::cout << "workers | early stop | mean latency | iterations/s | mean iterations | syncs | stopped early | same move as reference" << std::endl;
+        for(const Mode& mode : modes) {
+            MCTS::SearchConfig config;
+            config.useEarlyStop = mode.useEarlyStop;
+
+            double seconds = 0, iterationSum = 0;
+            unsigned int syncs = 0, stoppedEarly = 0, sameMove = 0;
+            for(unsigned int position = 0; position < positions; ++position) {
+                config.randomSeed = position + 1;
+                MCTS::RootParallelSearch search(mode.workers, config);
+                std::unique_ptr<MCTS::Puissance4> state(make_connect4_position(position % 16, position + 1));
+
+                const unsigned int bestMove = search.search_best_move(state.get(), iterations);
+                const MCTS::RootParallelStats& stats = search.get_last_stats();
+                seconds += stats.seconds;
+                iterationSum += stats.iterations;
+                syncs += stats.syncs;
+                stoppedEarly += stats.stoppedEarly ? 1 : 0;
+                sameMove += (bestMove == referenceMoves[position]) ? 1 : 0;
+            }
+
+            std::cout << std::setw(7) << mode.workers
+                << " | " << std::setw(10) << (mode.useEarlyStop ? "yes" : "no")
+                << " | " << std::setw(10) << 1000.0 * seconds / positions << "ms"
+                << " | " << std::setw(12) << std::setprecision(0) << iterationSum / seconds
+                << " | " << std::setw(15) << iterationSum / positions
+                << " | " << std::setw(5) << syncs / positions
+                << " | " << std::setw(13) << stoppedEarly
+                << " | " << std::setw(3) << sameMove << "/" << positions << std::setprecision(3) << std::endl;
+        }
+        return 0;
+    }
+
+} /* Benchmark */
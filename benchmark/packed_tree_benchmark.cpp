@@ -0,0 +1,95 @@
+#include "benchmarks.hpp"
+
+#include "MCTS.hpp"
+#include "packed_tree.hpp"
+
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace Benchmark {
+
+    namespace {
+
+        //random moves of the first position, the next ones going up to 11 moves
+        const unsigned int openingMoves = 6;
+
+        struct PackedResult {
+            double seconds;
+            double nodeCount;
+            double treeBytes;
+            unsigned int agreements;    //positions where the chosen move is the reference move
+        };
+
+        unsigned int search_node_tree(unsigned int position, unsigned int iterations, PackedResult& result) {
+            MCTS::MCTS tree(make_connect4_position(openingMoves + position % 6, position + 1));
+            MCTS::seed_random(position + 1);
+
+            Timer timer;
+            tree.run_iterations(iterations);
+            const MCTS::Node* best = tree.get_best_move();
+            result.seconds += timer.elapsed_seconds();
+
+            const MCTS::TreeStats stats = tree.tree_stats();
+            result.nodeCount += stats.nodeCount;
+            result.treeBytes += stats.get_total_bytes();
+            return (best == nullptr) ? 0 : best->get_move_index();
+        }
+
+        unsigned int search_packed_tree(unsigned int position, unsigned int iterations, size_t maximumNodes, PackedResult& result) {
+            MCTS::PackedTree tree(make_connect4_position(openingMoves + position % 6, position + 1), MCTS::SearchConfig(), maximumNodes);
+            MCTS::seed_random(position + 1);
+
+            Timer timer;
+            const unsigned int bestMove = tree.search_best_move(iterations);
+            result.seconds += timer.elapsed_seconds();
+            result.nodeCount += tree.get_node_count();
+            result.treeBytes += tree.get_memory_size();
+            return bestMove;
+        }
+
+    }
+
+    int run_packed_tree_benchmark(int argc, char** argv) {
+        const unsigned int iterations = get_argument(argc, argv, 1, 100000);
+        const unsigned int positions = get_argument(argc, argv, 2, 8);
+        const unsigned int referenceIterations = 10 * iterations;
+
+        //reference moves: Node tree search with ten times the budget
+        std::vector<unsigned int> referenceMoves(positions);
+        PackedResult reference = {0.0, 0.0, 0.0, 0};
+        for(unsigned int position = 0; position < positions; ++position)
+            referenceMoves[position] = search_node_tree(position, referenceIterations, reference);
+
+        std::cout << "Connect 4, " << positions << " positions, " << iterations << " iterations, reference moves from " << referenceIterations
+            << " Node tree iterations, " << sizeof(MCTS::Node) << " bytes per Node, " << sizeof(MCTS::PackedNode) << " + " << sizeof(uint32_t)
+            << " bytes per PackedNode" << std::endl;
+        std::cout << std::fixed << std::setprecision(2);
+        std::cout << "tree                    | iterations/s | nodes    | tree MB  | bytes/node | bytes/iteration | reference move" << std::endl;
+
+        //about two nodes per iteration on Connect 4: the reserved packed tree never grows its vectors
+        const size_t reservedNodes = static_cast<size_t>(iterations) * 3;
+        for(unsigned int mode = 0; mode < 3; ++mode) {
+            PackedResult result = {0.0, 0.0, 0.0, 0};
+            for(unsigned int position = 0; position < positions; ++position) {
+                unsigned int bestMove;
+                if(mode == 0)
+                    bestMove = search_node_tree(position, iterations, result);
+                else
+                    bestMove = search_packed_tree(position, iterations, (mode == 2) ? reservedNodes : 0, result);
+                result.agreements += (bestMove == referenceMoves[position]) ? 1 : 0;
+            }
+
+            const char* names[] = {"Node", "packed", "packed, 3 per iteration"};
+            std::cout << std::setw(23) << std::left << names[mode] << std::right
+                << " | " << std::setw(12) << std::setprecision(0) << static_cast<double>(iterations) * positions / result.seconds
+                << " | " << std::setw(8) << result.nodeCount / positions << std::setprecision(2)
+                << " | " << std::setw(8) << result.treeBytes / positions / (1024.0 * 1024.0)
+                << " | " << std::setw(10) << result.treeBytes / result.nodeCount
+                << " | " << std::setw(15) << result.treeBytes / (static_cast<double>(iterations) * positions)
+                << " | " << std::setw(3) << result.agreements << "/" << positions << std::endl;
+        }
+        return 0;
+    }
+
+} /* Benchmark */
@@ -0,0 +1,157 @@
+#include "perf_counters.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace Benchmark {
+
+#ifdef __linux__
+    namespace {
+
+        int open_counter(uint32_t type, uint64_t config, int groupFd) {
+            perf_event_attr attributes;
+            std::memset(&attributes, 0, sizeof(attributes));
+            attributes.size = sizeof(attributes);
+            attributes.type = type;
+            attributes.config = config;
+            attributes.disabled = (groupFd < 0) ? 1 : 0;
+            attributes.exclude_kernel = 1;
+            attributes.exclude_hv = 1;
+            attributes.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            //this thread, any cpu
+            return static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, groupFd, 0));
+        }
+
+        uint64_t cache_miss(uint64_t cache) {
+            return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        }
+
+    }
+#endif
+
+    PerfCounters::PerfCounters() {
+        _groupFds.fill(-1);
+        _groupSizes.fill(0);
+        _fds.fill(-1);
+        _groupIndex.fill(-1);
+
+#ifdef __linux__
+        const std::array<std::pair<uint32_t, uint64_t>, PerfEventCount> events = {{
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+            {PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_L1D)},
+            {PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_LL)},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+            {PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_DTLB)},
+        }};
+
+        //the first open event of a pair leads its group
+        for(int event = 0; event < PerfEventCount; ++event) {
+            const int group = event / 2;
+            const int fd = open_counter(events[event].first, events[event].second, _groupFds[group]);
+            if(fd < 0) {
+                if(_error.empty())
+                    _error = std::string("perf_event_open(") + get_event_name(static_cast<PerfEvent>(event)) + "): " + std::strerror(errno);
+                continue;
+            }
+            if(_groupFds[group] < 0)
+                _groupFds[group] = fd;
+            _fds[event] = fd;
+            _groupIndex[event] = _groupSizes[group]++;
+        }
+
+        if(this->is_available())
+            _error.clear();
+        for(int groupFd : _groupFds) {
+            if(groupFd < 0)
+                continue;
+            ioctl(groupFd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ioctl(groupFd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        }
+#else
+        _error = "hardware counters are only read on Linux";
+#endif
+    }
+
+    PerfCounters::~PerfCounters() {
+#ifdef __linux__
+        for(int fd : _fds) {
+            if(fd >= 0)
+                close(fd);
+        }
+#endif
+    }
+
+    bool PerfCounters::is_available() const {
+        for(int groupFd : _groupFds) {
+            if(groupFd >= 0)
+                return true;
+        }
+        return false;
+    }
+
+    bool PerfCounters::is_counted(PerfEvent event) const {
+        return _groupIndex[event] >= 0;
+    }
+
+    const std::string& PerfCounters::get_error() const {
+        return _error;
+    }
+
+    bool PerfCounters::read(PerfSample& sample) const {
+        sample.counts.fill(0);
+        sample.timeEnabled.fill(0);
+        sample.timeRunning.fill(0);
+#ifdef __linux__
+        if(not this->is_available())
+            return false;
+
+        for(int group = 0; group < GROUP_COUNT; ++group) {
+            if(_groupFds[group] < 0)
+                continue;
+            //counter count, time enabled, time running, then the counter values
+            uint64_t data[3 + 2];
+            if(::read(_groupFds[group], data, sizeof(data)) < static_cast<ssize_t>((3 + _groupSizes[group]) * sizeof(uint64_t)))
+                return false;
+            for(int event = group * 2; event < group * 2 + 2; ++event) {
+                if(_groupIndex[event] < 0)
+                    continue;
+                sample.counts[event] = data[3 + _groupIndex[event]];
+                sample.timeEnabled[event] = data[1];
+                sample.timeRunning[event] = data[2];
+            }
+        }
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    void PerfCounters::get_difference(const PerfSample& from, const PerfSample& to, PerfValues& values, std::array<bool, PerfEventCount>& counted) {
+        for(int event = 0; event < PerfEventCount; ++event) {
+            //not scheduled on the PMU during the interval: the count is not zero, it is unknown
+            const uint64_t running = to.timeRunning[event] - from.timeRunning[event];
+            counted[event] = running > 0;
+            values[event] = 0.0;
+            if(not counted[event])
+                continue;
+            //the kernel may share the counters with other groups: scale the interval count to the interval enabled time
+            const double scale = static_cast<double>(to.timeEnabled[event] - from.timeEnabled[event]) / running;
+            values[event] = (to.counts[event] - from.counts[event]) * scale;
+        }
+    }
+
+    const char* PerfCounters::get_event_name(PerfEvent event) {
+        static const char* names[PerfEventCount] = {"cycles", "instructions", "L1D misses", "LLC misses", "branch misses", "dTLB misses"};
+        return names[event];
+    }
+
+} /* Benchmark */
@@ -0,0 +1,102 @@
+#ifndef MCTS_BENCHMARK_PERF_COUNTERS_HPP
+#define MCTS_BENCHMARK_PERF_COUNTERS_HPP
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+/**
+ * \file    perf_counters.hpp
+ * \author  Baptiste Hudyma
+ * \version 1.0
+ * \date    11 mars 2021
+ *
+ * \brief   Hardware performance counters of the calling thread, with Linux perf_event_open
+ */
+
+namespace Benchmark {
+
+    /**
+     * \brief   Counted hardware events, by pairs counted in the same group
+     */
+    enum PerfEvent {
+        Cycles = 0,
+        Instructions,
+        L1DataMisses,
+        LastLevelCacheMisses,
+        BranchMisses,
+        DataTLBMisses,
+        PerfEventCount
+    };
+
+    typedef std::array<double, PerfEventCount> PerfValues;
+
+    /**
+     * \brief   Raw counts of a read, with the times of the group of each event: scale the differences of two reads, not the counts
+     */
+    struct PerfSample {
+        std::array<uint64_t, PerfEventCount> counts;
+        std::array<uint64_t, PerfEventCount> timeEnabled;
+        std::array<uint64_t, PerfEventCount> timeRunning;   //time the group was scheduled on the PMU
+    };
+
+    /**
+     * \brief   User space counters of the calling thread, in small groups read together
+     * \details The PMU schedules a group all or nothing: the events are opened by pairs (cycles and instructions, cache misses,
+     *          branch and dTLB misses) so that a group still fits when a counter is taken (NMI watchdog, another profiler).
+     *          The counters that can not be opened (no permission, no PMU in a virtual machine, unsupported event) are reported
+     *          as unavailable, every other method still works, reading zeros.
+     */
+    class PerfCounters {
+        public:
+            PerfCounters();
+            ~PerfCounters();
+
+            /**
+             * \return True if at least one counter is open
+             */
+            bool is_available() const;
+
+            /**
+             * \return True if this event is counted
+             */
+            bool is_counted(PerfEvent event) const;
+
+            /**
+             * \return Why no counter could be opened, empty if is_available
+             */
+            const std::string& get_error() const;
+
+            /**
+             * \brief Read the current raw counts and times of every group
+             *
+             * \return False, the sample being zeros, if no counter is open or a read failed
+             */
+            bool read(PerfSample& sample) const;
+
+            /**
+             * \brief   Counts between two reads, scaled by the share of that interval the group of each event ran on the PMU
+             *
+             * \param[out] counted  For each event, true if its group ran during the interval. The value of the other events is 0, as
+             *                      their counts are unknown rather than zeros
+             */
+            static void get_difference(const PerfSample& from, const PerfSample& to, PerfValues& values, std::array<bool, PerfEventCount>& counted);
+
+            static const char* get_event_name(PerfEvent event);
+
+        private:
+            PerfCounters(const PerfCounters&) = delete;
+            PerfCounters& operator=(const PerfCounters&) = delete;
+
+            static const int GROUP_COUNT = PerfEventCount / 2;
+
+            std::array<int, GROUP_COUNT> _groupFds;       //leader of each group, -1 if none of its events is open
+            std::array<int, GROUP_COUNT> _groupSizes;
+            std::array<int, PerfEventCount> _fds;
+            std::array<int, PerfEventCount> _groupIndex;  //position of each counter in the reads of its group, -1 if not counted
+            std::string _error;
+    };
+
+} /* Benchmark */
+
+#endif
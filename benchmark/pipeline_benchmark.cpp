@@ -0,0 +1,43 @@
+#include "benchmarks.hpp"
+
+#include "MCTS.hpp"
+
+#include <iomanip>
+#include <iostream>
+
+namespace Benchmark {
+
+    int run_pipeline_benchmark(int argc, char** argv) {
+        const unsigned int iterations = get_argument(argc, argv, 1, 200000);
+        const unsigned int rolloutThreads = get_argument(argc, argv, 2, 0);
+        const unsigned int queueDepth = get_argument(argc, argv, 3, 64);
+        const unsigned int selectionThreads = get_argument(argc, argv, 4, 1);
+
+        std::cout << std::fixed << std::setprecision(2);
+        std::cout << "Connect 4 opening, " << iterations << " iterations" << std::endl;
+
+        {
+            MCTS::seed_random(1);
+            MCTS::MCTS tree(new MCTS::Puissance4());
+            Timer timer;
+            const unsigned int bestMove = tree.search_best_move(iterations);
+            const double seconds = timer.elapsed_seconds();
+            std::cout << "sequential : " << static_cast<unsigned int>(iterations / seconds) << " iterations/s, best move " << bestMove << std::endl;
+        }
+
+        MCTS::SearchConfig config;
+        config.pipelineRolloutThreads = rolloutThreads;
+        config.pipelineQueueDepth = queueDepth;
+        config.pipelineSelectionThreads = selectionThreads;
+        MCTS::MCTS tree(new MCTS::Puissance4(), config);
+        MCTS::PipelineStats stats;
+        const unsigned int bestMove = tree.search_best_move_pipeline(iterations, &stats);
+        std::cout << "pipeline   : " << static_cast<unsigned int>(stats.iterations / stats.seconds) << " iterations/s, best move " << bestMove
+            << " (" << stats.selectionThreads << " selection, " << stats.rolloutThreads << " rollout, 1 backpropagation threads, queue depth " << queueDepth << ")" << std::endl;
+        std::cout << "utilization: selection " << 100.0 * stats.selectionUtilization
+            << "%, rollout " << 100.0 * stats.rolloutUtilization
+            << "%, backpropagation " << 100.0 * stats.backpropagationUtilization << "%" << std::endl;
+        return 0;
+    }
+
+} /* Benchmark */
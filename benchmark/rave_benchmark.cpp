@@ -0,0 +1,93 @@
+#include "benchmarks.hpp"
+
+#include "MCTS.hpp"
+
+#include <iomanip>
+#include <iostream>
+
+namespace Benchmark {
+
+    namespace {
+
+        const unsigned int openingMoves = 6;    //random moves played before each benchmark position
+        const unsigned int runsPerPosition = 3;
+
+        struct ConvergenceResult {
+            unsigned int stableIteration;   //iteration count after which the best move never changed
+            unsigned int bestMove;
+            double seconds;
+        };
+
+        /**
+         * \brief Search a position by steps, tracking the iteration where the best move settled
+         */
+        ConvergenceResult measure_convergence(unsigned int position, unsigned int run, const MCTS::SearchConfig& config, unsigned int iterations, unsigned int step) {
+            MCTS::MCTS tree(make_connect4_position(openingMoves, position + 1), config);
+            MCTS::seed_random(position * 1000 + run);
+
+            ConvergenceResult result = {0, 0, 0.0};
+            Timer timer;
+            bool isFirst = true;
+            for(unsigned int done = step; done <= iterations; done += step) {
+                const unsigned int bestMove = tree.search_best_move(step);
+                if(isFirst or bestMove != result.bestMove) {
+                    result.bestMove = bestMove;
+                    result.stableIteration = done;
+                    isFirst = false;
+                }
+            }
+            result.seconds = timer.elapsed_seconds();
+            return result;
+        }
+
+    }
+
+    int run_rave_benchmark(int argc, char** argv) {
+        const unsigned int iterations = get_argument(argc, argv, 1, 20000);
+        const unsigned int positions = get_argument(argc, argv, 2, 8);
+        const unsigned int step = std::max(1u, iterations / 40);
+
+        MCTS::SearchConfig uctConfig;
+        MCTS::SearchConfig raveConfig;
+        raveConfig.useRave = true;
+
+        std::cout << "Connect 4, " << positions << " positions, " << runsPerPosition << " runs each, "
+            << iterations << " iterations checked every " << step << std::endl;
+        std::cout << "position | reference | UCT stable at / agree | RAVE stable at / agree" << std::endl;
+
+        double uctStableSum = 0, raveStableSum = 0;
+        unsigned int uctAgree = 0, raveAgree = 0;
+        double uctSeconds = 0, raveSeconds = 0;
+        for(unsigned int position = 0; position < positions; ++position) {
+            //long plain UCT search as the quality reference
+            const unsigned int reference = measure_convergence(position, runsPerPosition, uctConfig, iterations * 4, iterations * 4).bestMove;
+
+            std::cout << std::setw(8) << position << " | " << std::setw(9) << reference << " |";
+            for(const bool useRave : {false, true}) {
+                double stableSum = 0;
+                unsigned int agree = 0;
+                for(unsigned int run = 0; run < runsPerPosition; ++run) {
+                    const ConvergenceResult result = measure_convergence(position, run, useRave ? raveConfig : uctConfig, iterations, step);
+                    stableSum += result.stableIteration;
+                    agree += (result.bestMove == reference) ? 1 : 0;
+                    (useRave ? raveSeconds : uctSeconds) += result.seconds;
+                }
+                std::cout << std::setw(15) << static_cast<unsigned int>(stableSum / runsPerPosition) << " / " << agree << "/" << runsPerPosition << " |";
+                (useRave ? raveStableSum : uctStableSum) += stableSum;
+                (useRave ? raveAgree : uctAgree) += agree;
+            }
+            std::cout << std::endl;
+        }
+
+        const double runs = positions * runsPerPosition;
+        std::cout << std::fixed << std::setprecision(1);
+        std::cout << "UCT : mean iterations to stable best move " << uctStableSum / runs
+            << ", reference agreement " << 100.0 * uctAgree / runs << "%"
+            << ", " << runs * iterations / uctSeconds << " iterations/s" << std::endl;
+        std::cout << "RAVE: mean iterations to stable best move " << raveStableSum / runs
+            << ", reference agreement " << 100.0 * raveAgree / runs << "%"
+            << ", " << runs * iterations / raveSeconds << " iterations/s" << std::endl;
+        return 0;
+    }
+
+} /* Benchmark */
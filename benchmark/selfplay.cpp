@@ -0,0 +1,248 @@
+#include "benchmarks.hpp"
+
+#include "MCTS.hpp"
+#include "game_record.hpp"
+#include "random.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * \file    selfplay.cpp
+ * \author  Baptiste Hudyma
+ * \version 1.0
+ * \date    11 mars 2021
+ *
+ * \brief   Generate Connect 4 self-play games in bulk, written to a game record file
+ * \details Every worker thread plays its own games, one tree per game kept from move to move. The first plies are sampled
+ *          in proportion to the root visits to vary the games, then the best move is played.
+ *          With --summary, the records of a file are streamed back and summarized instead.
+ */
+
+namespace {
+
+    struct SelfPlaySettings {
+        unsigned int games = 1000;
+        unsigned int threads = 0;
+        unsigned int iterations = 2000;     //per move
+        unsigned int openingMoves = 0;      //random moves before the search starts, recorded without visits
+        unsigned int samplePlies = 8;       //plies sampled in proportion to the root visits
+        unsigned int seed = 1;
+        std::string output = "selfplay.bin";
+        std::string summary;                //record file to summarize instead of playing
+    };
+
+    /**
+     * \brief Choose a root child in proportion to its visits
+     */
+    unsigned int sample_move(const MCTS::Node* root) {
+        unsigned long long visitSum = 0;
+        for(const MCTS::Node* child : root->get_children())
+            visitSum += child->get_visit_count();
+        if(visitSum > 0) {
+            unsigned long long target = (static_cast<unsigned long long>(MCTS::random_index(1u << 31)) * visitSum) >> 31;
+            for(const MCTS::Node* child : root->get_children()) {
+                if(target < child->get_visit_count())
+                    return child->get_move_index();
+                target -= child->get_visit_count();
+            }
+        }
+        return MCTS::random_index(root->get_move_count());
+    }
+
+    void play_game(const SelfPlaySettings& settings, unsigned int gameIndex, MCTS::GameRecord& record) {
+        //the random opening of make_connect4_position, recorded so that the games replay from the empty board
+        MCTS::seed_random(settings.seed * 1000003u + gameIndex);
+        MCTS::Puissance4* state = new MCTS::Puissance4();
+        MCTS::Puissance4* treeState = new MCTS::Puissance4();
+        record.clear();
+        record.moveCount = MCTS::Puissance4::_boardWidth;
+        for(unsigned int i = 0; i < settings.openingMoves; ++i) {
+            const unsigned int moveIndex = MCTS::random_index(state->get_move_count());
+            MCTS::Puissance4* nextState = state->do_move(moveIndex);
+            if(nextState->is_game_over()) {
+                //keep the last playable position
+                delete nextState;
+                break;
+            }
+            record.add_ply(state->get_move_id(moveIndex), {});
+            MCTS::Puissance4* nextTreeState = treeState->do_move(moveIndex);
+            delete state;
+            delete treeState;
+            state = nextState;
+            treeState = nextTreeState;
+        }
+        const size_t openingPlies = record.get_ply_count();
+        MCTS::MCTS tree(treeState);
+
+        std::vector<std::pair<unsigned int, unsigned int>> visitCounts;
+        while(not state->is_game_over()) {
+            tree.run_iterations(settings.iterations);
+
+            const MCTS::Node* root = tree.get_root();
+            visitCounts.clear();
+            for(const MCTS::Node* child : root->get_children())
+                visitCounts.emplace_back(state->get_move_id(child->get_move_index()), child->get_visit_count());
+
+            unsigned int moveIndex;
+            if(record.get_ply_count() - openingPlies < settings.samplePlies) {
+                moveIndex = sample_move(root);
+            }
+            else {
+                const MCTS::Node* bestChild = tree.get_best_move();
+                moveIndex = (bestChild == nullptr) ? 0 : bestChild->get_move_index();
+            }
+            record.add_ply(state->get_move_id(moveIndex), visitCounts);
+
+            tree.advance_root(moveIndex);
+            MCTS::Puissance4* nextState = state->do_move(moveIndex);
+            delete state;
+            state = nextState;
+        }
+        record.score = state->get_score();
+        delete state;
+    }
+
+    /**
+     * \brief Stream the records of a file and show the results, game lengths and first moves
+     */
+    int summarize(const std::string& path) {
+        MCTS::GameRecordReader reader(path);
+        if(not reader.is_open()) {
+            std::cerr << "Could not read the game records of " << path << std::endl;
+            return 1;
+        }
+
+        Benchmark::Timer timer;
+        MCTS::GameRecord record;
+        unsigned long long games = 0, plies = 0, visitEntries = 0;
+        unsigned long long results[3] = {0, 0, 0};  //O wins, draws, X wins
+        std::map<unsigned int, unsigned long long> firstMoves;
+        while(reader.next(record)) {
+            games += 1;
+            plies += record.get_ply_count();
+            visitEntries += record.visits.size();
+            results[(record.score < 0.25f) ? 0 : ((record.score > 0.75f) ? 2 : 1)] += 1;
+            if(record.get_ply_count() > 0)
+                firstMoves[record.moves[0]] += 1;
+        }
+        const double seconds = timer.elapsed_seconds();
+
+        std::cout << path << ": " << games << " games, " << reader.get_file_size() << " bytes, read in " << std::fixed << std::setprecision(3) << seconds << " s" << std::endl;
+        if(games == 0)
+            return 0;
+        std::cout << std::setprecision(1)
+                  << "X wins " << 100.0 * results[2] / games << "%, draws " << 100.0 * results[1] / games << "%, O wins " << 100.0 * results[0] / games << "%" << std::endl
+                  << "Mean game length " << static_cast<double>(plies) / games << " plies, " << static_cast<double>(visitEntries) / std::max(1ull, plies) << " visited root children per ply, "
+                  << std::setprecision(2) << static_cast<double>(reader.get_file_size()) / std::max(1ull, plies) << " bytes per ply" << std::endl;
+        std::cout << "First moves:";
+        for(const std::pair<const unsigned int, unsigned long long>& move : firstMoves)
+            std::cout << " " << move.first << ": " << move.second;
+        std::cout << std::endl;
+        return 0;
+    }
+
+    void show_usage(const char* program) {
+        std::cout << "Usage: " << program << " [options]" << std::endl
+                  << "  --games N          games to play (1000)" << std::endl
+                  << "  --threads N        games played in parallel, 0 for one per hardware thread (0)" << std::endl
+                  << "  --iterations N     iterations per move (2000)" << std::endl
+                  << "  --opening N        random moves before the search starts, recorded without visits (0)" << std::endl
+                  << "  --sample-plies N   plies chosen in proportion to the root visits instead of the best move (8)" << std::endl
+                  << "  --seed N           seed of the games (1)" << std::endl
+                  << "  --output FILE      record file, appended to (selfplay.bin)" << std::endl
+                  << "  --summary FILE     summarize the records of a file instead of playing" << std::endl;
+    }
+
+    bool parse_arguments(int argc, char** argv, SelfPlaySettings& settings) {
+        for(int i = 1; i + 1 < argc; i += 2) {
+            const std::string option = argv[i];
+            const std::string value = argv[i + 1];
+            if(option == "--games")
+                settings.games = std::stoul(value);
+            else if(option == "--threads")
+                settings.threads = std::stoul(value);
+            else if(option == "--iterations")
+                settings.iterations = std::stoul(value);
+            else if(option == "--opening")
+                settings.openingMoves = std::stoul(value);
+            else if(option == "--sample-plies")
+                settings.samplePlies = std::stoul(value);
+            else if(option == "--seed")
+                settings.seed = std::stoul(value);
+            else if(option == "--output")
+                settings.output = value;
+            else if(option == "--summary")
+                settings.summary = value;
+            else
+                return false;
+        }
+        return argc % 2 == 1;
+    }
+
+}
+
+
+
+int main(int argc, char** argv) {
+    SelfPlaySettings settings;
+    if(not parse_arguments(argc, argv, settings)) {
+        show_usage(argv[0]);
+        return 1;
+    }
+    if(not settings.summary.empty())
+        return summarize(settings.summary);
+
+    MCTS::GameRecordWriter writer(settings.output);
+    if(not writer.is_open()) {
+        std::cerr << "Could not open " << settings.output << " as a game record file" << std::endl;
+        return 1;
+    }
+    if(settings.threads == 0)
+        settings.threads = std::max(1u, std::thread::hardware_concurrency());
+    settings.threads = std::min(settings.threads, std::max(1u, settings.games));
+    std::cout << settings.games << " Connect 4 self-play games on " << settings.threads << " threads, " << settings.iterations << " iterations per move, to " << settings.output << std::endl;
+
+    std::atomic<unsigned int> nextGame(0);
+    std::atomic<unsigned int> finishedGames(0);
+    std::atomic<unsigned long long> plies(0);
+    std::mutex outputMutex;
+    const unsigned int reportInterval = std::max(1u, settings.games / 10);
+
+    Benchmark::Timer timer;
+    std::vector<std::thread> workers;
+    for(unsigned int t = 0; t < settings.threads; ++t) {
+        workers.emplace_back([&]() {
+            MCTS::GameRecord record;
+            unsigned int gameIndex;
+            while((gameIndex = nextGame++) < settings.games) {
+                MCTS::seed_random(settings.seed * 1000003u + gameIndex);
+                play_game(settings, gameIndex, record);
+                if(not writer.append(record)) {
+                    std::lock_guard<std::mutex> lock(outputMutex);
+                    std::cerr << "Could not write the game " << gameIndex << std::endl;
+                }
+                plies += record.get_ply_count();
+                const unsigned int finished = ++finishedGames;
+                if(finished % reportInterval == 0) {
+                    std::lock_guard<std::mutex> lock(outputMutex);
+                    std::cout << "  " << finished << "/" << settings.games << " games, " << std::fixed << std::setprecision(1) << timer.elapsed_seconds() << " s" << std::endl;
+                }
+            }
+        });
+    }
+    for(std::thread& worker : workers)
+        worker.join();
+
+    const double seconds = timer.elapsed_seconds();
+    std::cout << std::fixed << std::setprecision(1) << settings.games / seconds << " games/s, " << plies / seconds << " plies/s, "
+              << writer.get_written_bytes() << " bytes written (" << std::setprecision(2) << static_cast<double>(writer.get_written_bytes()) / std::max(1ull, plies.load()) << " bytes per ply)" << std::endl;
+    return 0;
+}
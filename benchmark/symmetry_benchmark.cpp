@@ -0,0 +1,82 @@
+#include "benchmarks.hpp"
+
+#include "MCTS.hpp"
+#include "tictactoe.hpp"
+
+#include <iomanip>
+#include <iostream>
+
+namespace Benchmark {
+
+    namespace {
+
+        /**
+         * \brief Solve TicTacToe from the empty board: search until the root is closed, every line of play being explored
+         */
+        void solve_tictactoe(bool useSymmetries, unsigned int maxIterations) {
+            MCTS::SearchConfig config;
+            config.useSymmetries = useSymmetries;
+            MCTS::MCTS tree(new MCTS::Game_State(), config);
+            MCTS::seed_random(1);
+
+            Timer timer;
+            unsigned int iterations = 0;
+            while(iterations < maxIterations and not tree.get_root()->is_closed())
+                iterations += tree.run_iterations(std::min(1024u, maxIterations - iterations));
+            const double seconds = timer.elapsed_seconds();
+
+            std::cout << std::setw(12) << (useSymmetries ? "symmetries" : "plain")
+                << std::setw(12) << iterations
+                << std::setw(12) << tree.get_root()->count_nodes()
+                << std::setw(10) << (tree.get_root()->is_closed() ? "yes" : "no")
+                << std::setw(12) << std::fixed << std::setprecision(3) << seconds << std::endl;
+        }
+
+        /**
+         * \brief Search the empty Connect 4 board, and report the spread of the tree near the root
+         */
+        void search_connect4(bool useSymmetries, unsigned int iterations) {
+            MCTS::SearchConfig config;
+            config.useSymmetries = useSymmetries;
+            MCTS::MCTS tree(make_connect4_position(0, 1), config);
+            MCTS::seed_random(1);
+
+            Timer timer;
+            tree.run_iterations(iterations);
+            const double seconds = timer.elapsed_seconds();
+
+            const MCTS::TreeStats stats = tree.tree_stats();
+            unsigned int openingNodes = 0;
+            for(size_t depth = 0; depth < stats.depths.size() and depth <= 4; ++depth)
+                openingNodes += stats.depths[depth].nodeCount;
+            const MCTS::Node* best = tree.get_best_move();
+
+            std::cout << std::setw(12) << (useSymmetries ? "symmetries" : "plain")
+                << std::setw(10) << tree.get_root()->get_children().size()
+                << std::setw(14) << openingNodes
+                << std::setw(10) << stats.depths.size() - 1
+                << std::setw(14) << ((best == nullptr) ? 0 : best->get_visit_count())
+                << std::setw(10) << ((best == nullptr) ? 0 : best->get_move_index())
+                << std::setw(12) << std::fixed << std::setprecision(3) << seconds << std::endl;
+        }
+
+    }
+
+    int run_symmetry_benchmark(int argc, char** argv) {
+        const unsigned int iterations = get_argument(argc, argv, 1, 200000);
+        const unsigned int maxSolveIterations = get_argument(argc, argv, 2, 2000000);
+
+        std::cout << "TicTacToe solved from the empty board, at most " << maxSolveIterations << " iterations" << std::endl;
+        std::cout << std::setw(12) << "mode" << std::setw(12) << "iterations" << std::setw(12) << "nodes" << std::setw(10) << "solved" << std::setw(12) << "time (s)" << std::endl;
+        solve_tictactoe(false, maxSolveIterations);
+        solve_tictactoe(true, maxSolveIterations);
+
+        std::cout << std::endl << "Connect 4 empty board, " << iterations << " iterations" << std::endl;
+        std::cout << std::setw(12) << "mode" << std::setw(10) << "root" << std::setw(14) << "depth <= 4" << std::setw(10) << "depth"
+            << std::setw(14) << "best visits" << std::setw(10) << "best" << std::setw(12) << "time (s)" << std::endl;
+        search_connect4(false, iterations);
+        search_connect4(true, iterations);
+        return 0;
+    }
+
+} /* Benchmark */
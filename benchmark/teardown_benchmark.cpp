@@ -0,0 +1,77 @@
+#include "benchmarks.hpp"
+
+#include "MCTS.hpp"
+#include "tree_reclaimer.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace Benchmark {
+
+    namespace {
+
+        double percentile(std::vector<double> values, unsigned int percent) {
+            if(values.empty())
+                return 0;
+            std::sort(values.begin(), values.end());
+            return values[(values.size() - 1) * percent / 100];
+        }
+
+    }
+
+    int run_teardown_benchmark(int argc, char** argv) {
+        const unsigned int iterations = get_argument(argc, argv, 1, 50000);
+        const unsigned int games = get_argument(argc, argv, 2, 4);
+        const unsigned int treeIterations = get_argument(argc, argv, 3, 500000);
+
+        std::cout << "Connect 4 self play with tree reuse, " << games << " games, " << iterations << " iterations per move" << std::endl;
+        std::cout << std::fixed << std::setprecision(2);
+        std::cout << "teardown   | moves | move p50   | move p99   | advance_root p99 | advance_root max | ~MCTS of a " << treeIterations << " iterations tree" << std::endl;
+
+        for(bool background : {false, true}) {
+            MCTS::SearchConfig config;
+            config.reclaimInBackground = background;
+
+            std::vector<double> moveLatencies, advanceLatencies;
+            for(unsigned int game = 0; game < games; ++game) {
+                MCTS::MCTS tree(make_connect4_position(0, game + 1), config);
+                MCTS::seed_random(game + 1);
+
+                while(not tree.get_root()->is_game_over()) {
+                    //move to move latency: from the previous move to the search result
+                    Timer moveTimer;
+                    const unsigned int move = tree.search_best_move(iterations);
+                    moveLatencies.push_back(moveTimer.elapsed_seconds());
+
+                    Timer advanceTimer;
+                    tree.advance_root(move);
+                    const double advanceSeconds = advanceTimer.elapsed_seconds();
+                    advanceLatencies.push_back(advanceSeconds);
+                    moveLatencies.back() += advanceSeconds;
+                }
+            }
+
+            std::unique_ptr<MCTS::MCTS> bigTree(new MCTS::MCTS(make_connect4_position(0, 1), config));
+            MCTS::seed_random(1);
+            bigTree->run_iterations(treeIterations);
+            Timer destructionTimer;
+            bigTree.reset();
+            const double destructionSeconds = destructionTimer.elapsed_seconds();
+            //do not let the freeing of this mode overlap the next one
+            MCTS::TreeReclaimer::get_shared().wait_idle();
+
+            std::cout << std::left << std::setw(10) << (background ? "background" : "caller") << std::right
+                << " | " << std::setw(5) << moveLatencies.size()
+                << " | " << std::setw(8) << 1000.0 * percentile(moveLatencies, 50) << "ms"
+                << " | " << std::setw(8) << 1000.0 * percentile(moveLatencies, 99) << "ms"
+                << " | " << std::setw(14) << 1000.0 * percentile(advanceLatencies, 99) << "ms"
+                << " | " << std::setw(14) << 1000.0 * percentile(advanceLatencies, 100) << "ms"
+                << " | " << std::setw(8) << 1000.0 * destructionSeconds << "ms" << std::endl;
+        }
+        return 0;
+    }
+
+} /* Benchmark */
@@ -0,0 +1,64 @@
+#include "benchmarks.hpp"
+#include "connect4_match.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+namespace Benchmark {
+
+    int run_time_manager_benchmark(int argc, char** argv) {
+        const unsigned int games = get_argument(argc, argv, 1, 40);
+        const unsigned int gameMilliseconds = get_argument(argc, argv, 2, 1000);
+        const unsigned int incrementMilliseconds = get_argument(argc, argv, 3, 0);
+        //fewer expected moves make the flat budgets spend as much of the clock as the adaptive ones, for a fair comparison
+        const unsigned int flatExpectedMoves = get_argument(argc, argv, 4, PlayerSettings().timeControl.expectedMoves);
+        const unsigned int threads = std::max(1u, std::thread::hardware_concurrency());
+
+        //same clock, adaptive against flat budgets
+        PlayerSettings players[2];
+        for(PlayerSettings& player : players) {
+            player.useGameClock = true;
+            player.timeControl.gameMilliseconds = gameMilliseconds;
+            player.timeControl.incrementMilliseconds = incrementMilliseconds;
+        }
+        players[1].timeControl.adaptive = false;
+        players[1].timeControl.expectedMoves = flatExpectedMoves;
+
+        std::cout << "Connect 4, " << games << " games on " << threads << " threads, " << gameMilliseconds << " + " << incrementMilliseconds
+            << " ms per game, adaptive (A, " << players[0].timeControl.expectedMoves << " expected moves) against flat (B, "
+            << flatExpectedMoves << " expected moves) time manager" << std::endl;
+        Timer timer;
+        const std::vector<GameResult> results = play_match(players, games, threads, 2, 1);
+        const double seconds = timer.elapsed_seconds();
+
+        unsigned int moves[2] = {0, 0};
+        unsigned int lostOnTime[2] = {0, 0};
+        double cpuSeconds[2] = {0.0, 0.0};
+        for(const GameResult& result : results) {
+            for(unsigned int side = 0; side < 2; ++side) {
+                moves[side] += result.moves[side];
+                cpuSeconds[side] += result.cpuSeconds[side];
+                lostOnTime[side] += result.lostOnTime[side] ? 1 : 0;
+            }
+        }
+        const MatchScore score = get_match_score(results);
+
+        std::cout << std::fixed << std::setprecision(1);
+        std::cout << "side     | ms per move | ms per game | clock used | lost on time" << std::endl;
+        for(unsigned int side = 0; side < 2; ++side) {
+            const double perGame = 1000.0 * cpuSeconds[side] / std::max(1u, games);
+            std::cout << std::setw(8) << ((side == 0) ? "adaptive" : "flat")
+                << " | " << std::setw(11) << 1000.0 * cpuSeconds[side] / std::max(1u, moves[side])
+                << " | " << std::setw(11) << perGame
+                << " | " << std::setw(9) << 100.0 * perGame / std::max(1u, gameMilliseconds + incrementMilliseconds * moves[side] / std::max(1u, games)) << "%"
+                << " | " << std::setw(12) << lostOnTime[side] << std::endl;
+        }
+        std::cout << "Adaptive: " << score.wins << " wins, " << score.draws << " draws, " << score.losses << " losses, score " << std::setprecision(2)
+            << 100.0 * score.score << "% +- " << 100.0 * score.margin << "%, Elo " << std::setprecision(1) << elo_difference(score.score)
+            << " [" << elo_difference(score.score - score.margin) << ", " << elo_difference(score.score + score.margin) << "], " << seconds << " s" << std::endl;
+        return 0;
+    }
+
+} /* Benchmark */
@@ -0,0 +1,41 @@
+#include "benchmarks.hpp"
+
+#include "MCTS.hpp"
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+namespace Benchmark {
+
+    int run_tree_stats_benchmark(int argc, char** argv) {
+        const unsigned int iterations = get_argument(argc, argv, 1, 200000);
+
+        MCTS::MCTS tree(make_connect4_position(0, 1));
+        MCTS::seed_random(1);
+        tree.search_best_move(iterations);
+
+        Timer timer;
+        const MCTS::TreeStats stats = tree.tree_stats();
+        const double seconds = timer.elapsed_seconds();
+
+        std::cout << std::fixed << std::setprecision(3);
+        std::cout << "Connect 4 tree of " << iterations << " iterations, report built in " << seconds << "s" << std::endl;
+        std::cout << stats.nodeCount << " nodes, depth " << stats.depths.size() - 1
+            << ", branching " << stats.get_mean_branching() << " (max " << stats.maxBranching << ")"
+            << ", " << 100.0 * stats.get_closed_fraction() << "% closed" << std::endl;
+        std::cout << "bytes: nodes " << stats.nodeBytes << ", states " << stats.stateBytes
+            << ", unexplored children " << stats.unexploredBytes << ", children lists " << stats.childrenListBytes
+            << ", total " << stats.get_total_bytes() << std::endl;
+        std::cout << "resident memory: " << stats.searchStartResidentBytes << " at the search start, peak " << stats.searchPeakResidentBytes << " during the search" << std::endl;
+
+        if(argc > 2) {
+            std::ofstream file(argv[2]);
+            stats.write_json(file);
+            file << std::endl;
+            std::cout << "JSON report written to " << argv[2] << std::endl;
+        }
+        return 0;
+    }
+
+} /* Benchmark */
@@ -0,0 +1,265 @@
+#include "benchmarks.hpp"
+#include "connect4_match.hpp"
+#include "random.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * \file    tuner.cpp
+ * \author  Baptiste Hudyma
+ * \version 1.0
+ * \date    11 mars 2021
+ *
+ * \brief   Tune numeric search options for the playing strength at a fixed thread CPU time per move, with SPSA on Connect 4 self-play
+ * \details Each round plays a match between two perturbations of the current values, on every core, and moves the values
+ *          along the estimated gradient of the score (simultaneous perturbation stochastic approximation). The values are tuned
+ *          in [0, 1] over the range of each option, so that options of different scales move alike. The tuned configuration
+ *          is then played against the starting one, and the stronger of the two is reported.
+ */
+
+namespace {
+
+    //SPSA gain sequences: a / (k + 1 + A)^alpha and c / (k + 1)^gamma, in the [0, 1] range of each option
+    const double STEP_GAIN = 0.1;
+    const double STEP_DECAY = 0.602;
+    const double PERTURBATION_GAIN = 0.15;
+    const double PERTURBATION_DECAY = 0.101;
+
+    struct TunedOption {
+        std::string name;
+        double minimum;
+        double maximum;
+        double position;                    //current value, in [0, 1] over [minimum, maximum]
+        bool isInteger;                     //values rounded to the nearest integer, as the option rejects fractions
+    };
+
+    struct TunerSettings {
+        unsigned int rounds = 30;
+        unsigned int gamesPerRound = 16;
+        unsigned int verificationGames = 200;
+        unsigned int threads = 0;
+        unsigned int openingMoves = 2;
+        unsigned int seed = 1;
+        std::vector<TunedOption> options;
+        Benchmark::PlayerSettings player;   //starting configuration and budget
+    };
+
+    double get_value(const TunedOption& option, double position) {
+        const double value = option.minimum + std::min(1.0, std::max(0.0, position)) * (option.maximum - option.minimum);
+        return option.isInteger ? std::round(value) : value;
+    }
+
+    /**
+     * \return The value of an option at a position, as set_search_option parses it
+     */
+    std::string to_option_value(const TunedOption& option, double position) {
+        std::ostringstream value;
+        if(option.isInteger)
+            value << static_cast<unsigned long long>(get_value(option, position));
+        else
+            value << std::setprecision(4) << get_value(option, position);
+        return value.str();
+    }
+
+    /**
+     * \brief   Set the tuned options of a player at the given positions
+     * \details Throws std::invalid_argument if an option rejects its value, rather than playing the starting value under the tuned name
+     */
+    Benchmark::PlayerSettings make_player(const TunerSettings& settings, const std::vector<double>& positions) {
+        Benchmark::PlayerSettings player = settings.player;
+        for(size_t i = 0; i < settings.options.size(); ++i) {
+            const std::string value = to_option_value(settings.options[i], positions[i]);
+            if(not MCTS::set_search_option(player.config, settings.options[i].name, value))
+                throw std::invalid_argument("--" + settings.options[i].name + " rejects the tuned value " + value);
+        }
+        return player;
+    }
+
+    /**
+     * \brief   Parse a tuned option, written NAME:MIN:MAX, and start it at its value in the starting configuration
+     * \details The integer options (is_integer_search_option) take a non negative range, and are tuned continuously but played rounded
+     */
+    bool parse_tuned_option(const std::string& text, const MCTS::SearchConfig& config, TunedOption& option) {
+        const size_t first = text.find(':');
+        const size_t second = text.find(':', first + 1);
+        if(first == std::string::npos or second == std::string::npos)
+            return false;
+        option.name = text.substr(0, first);
+        if(MCTS::is_search_flag(option.name) or (MCTS::get_search_option(config, option.name).empty() and option.name != "fpu"))
+            return false;
+        try {
+            option.minimum = std::stod(text.substr(first + 1, second - first - 1));
+            option.maximum = std::stod(text.substr(second + 1));
+        }
+        catch(const std::logic_error&) {
+            return false;
+        }
+        option.isInteger = MCTS::is_integer_search_option(option.name);
+        if(not (option.maximum > option.minimum) or (option.isInteger and option.minimum < 0.0))
+            return false;
+
+        //options without a value (first play urgency not set) start at the middle of their range
+        const std::string startValue = MCTS::get_search_option(config, option.name);
+        option.position = 0.5;
+        if(not startValue.empty())
+            option.position = std::min(1.0, std::max(0.0, (std::stod(startValue) - option.minimum) / (option.maximum - option.minimum)));
+        return true;
+    }
+
+    void show_usage(const char* program, const TunerSettings& defaults) {
+        std::cout << "Usage: " << program << " [options]" << std::endl
+                  << "  --tune NAME:MIN:MAX  numeric search option to tune and its range, repeatable (exploration:0.1:4)," << std::endl
+                  << "                       integer options (expand, batch, iterations...) are played rounded" << std::endl
+                  << "  --rounds N           SPSA rounds (30)" << std::endl
+                  << "  --games N            games per round, by pairs with swapped colors (16)" << std::endl
+                  << "  --verify N           games of the tuned configuration against the starting one (200)" << std::endl
+                  << "  --threads N          games played in parallel, 0 for one per hardware thread (0)" << std::endl
+                  << "  --opening N          random moves opening each pair of games (2)" << std::endl
+                  << "  --seed N             seed of the openings and searches (1)" << std::endl
+                  << "Starting configuration and budget of the players:" << std::endl;
+        Benchmark::show_player_options(std::cout, "", defaults.player);
+    }
+
+    bool parse_arguments(int argc, char** argv, TunerSettings& settings) {
+        std::vector<std::string> tunedOptions;
+        for(int i = 1; i < argc; ++i) {
+            const std::string option = argv[i];
+            if(option.rfind("--", 0) != 0)
+                return false;
+            const std::string name = option.substr(2);
+            if(MCTS::is_search_flag(name)) {
+                MCTS::set_search_option(settings.player.config, name);
+                continue;
+            }
+
+            if(i + 1 >= argc)
+                return false;
+            const std::string value = argv[++i];
+            if(option == "--tune")
+                tunedOptions.push_back(value);
+            else if(option == "--rounds")
+                settings.rounds = std::stoul(value);
+            else if(option == "--games")
+                settings.gamesPerRound = std::max(2ul, std::stoul(value));
+            else if(option == "--verify")
+                settings.verificationGames = std::stoul(value);
+            else if(option == "--threads")
+                settings.threads = std::stoul(value);
+            else if(option == "--opening")
+                settings.openingMoves = std::stoul(value);
+            else if(option == "--seed")
+                settings.seed = std::stoul(value);
+            else if(not Benchmark::set_player_option(settings.player, name, value))
+                return false;
+        }
+
+        const std::string unapplied = Benchmark::get_unapplied_options(settings.player);
+        if(not unapplied.empty()) {
+            std::cerr << unapplied << std::endl;
+            return false;
+        }
+
+        //the ranges start from the final starting configuration
+        if(tunedOptions.empty())
+            tunedOptions.push_back("exploration:0.1:4");
+        for(const std::string& text : tunedOptions) {
+            TunedOption option;
+            if(not parse_tuned_option(text, settings.player.config, option))
+                return false;
+            settings.options.push_back(option);
+        }
+
+        //both ends of every range must be playable (iterations above 2^32 - 1 are not)
+        try {
+            make_player(settings, std::vector<double>(settings.options.size(), 0.0));
+            make_player(settings, std::vector<double>(settings.options.size(), 1.0));
+        }
+        catch(const std::invalid_argument& error) {
+            std::cerr << error.what() << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+}
+
+
+
+int main(int argc, char** argv) {
+    TunerSettings settings;
+    settings.player.moveMilliseconds = 10.0;
+    const TunerSettings defaults = settings;
+    if(not parse_arguments(argc, argv, settings)) {
+        show_usage(argv[0], defaults);
+        return 1;
+    }
+    if(settings.threads == 0)
+        settings.threads = std::max(1u, std::thread::hardware_concurrency());
+    MCTS::seed_random(settings.seed);
+
+    std::cout << "SPSA on " << settings.threads << " threads, " << settings.rounds << " rounds of " << settings.gamesPerRound << " Connect 4 games, ";
+    if(settings.player.moveMilliseconds > 0.0)
+        std::cout << settings.player.moveMilliseconds << " ms CPU per move";
+    else
+        std::cout << settings.player.config.iterationsPerMove << " iterations per move";
+    const std::string startOptions = MCTS::to_search_options(settings.player.config);
+    std::cout << std::endl << "Starting configuration: " << (startOptions.empty() ? "default" : startOptions) << std::endl;
+
+    std::cout << std::fixed << std::setprecision(3);
+    const size_t dimension = settings.options.size();
+    const double stabilityOffset = settings.rounds / 10.0;
+    std::vector<double> positions(dimension);
+    for(size_t i = 0; i < dimension; ++i)
+        positions[i] = settings.options[i].position;
+
+    Benchmark::Timer timer;
+    for(unsigned int round = 0; round < settings.rounds; ++round) {
+        const double stepGain = STEP_GAIN * std::pow((1.0 + stabilityOffset) / (round + 1.0 + stabilityOffset), STEP_DECAY);
+        const double perturbation = PERTURBATION_GAIN / std::pow(round + 1.0, PERTURBATION_DECAY);
+
+        //random +-1 direction of every option
+        std::vector<double> directions(dimension);
+        std::vector<double> plus(dimension), minus(dimension);
+        for(size_t i = 0; i < dimension; ++i) {
+            directions[i] = (MCTS::random_index(2) == 0) ? -1.0 : 1.0;
+            plus[i] = positions[i] + perturbation * directions[i];
+            minus[i] = positions[i] - perturbation * directions[i];
+        }
+
+        const Benchmark::PlayerSettings players[2] = {make_player(settings, plus), make_player(settings, minus)};
+        const Benchmark::MatchScore score = Benchmark::get_match_score(Benchmark::play_match(players, settings.gamesPerRound, settings.threads, settings.openingMoves, settings.seed * 1000u + round));
+
+        //gradient of the score along each option
+        for(size_t i = 0; i < dimension; ++i)
+            positions[i] = std::min(1.0, std::max(0.0, positions[i] + stepGain * (score.score - 0.5) / (perturbation * directions[i])));
+
+        std::cout << "round " << std::setw(3) << round + 1 << ": score of + " << std::setw(6) << score.score << ",";
+        for(size_t i = 0; i < dimension; ++i)
+            std::cout << " " << settings.options[i].name << " " << to_option_value(settings.options[i], positions[i]);
+        std::cout << ", " << std::setprecision(1) << timer.elapsed_seconds() << " s" << std::setprecision(3) << std::endl;
+    }
+
+    //tuned against starting configuration
+    const Benchmark::PlayerSettings players[2] = {make_player(settings, positions), settings.player};
+    const std::string tunedOptions = MCTS::to_search_options(players[0].config);
+    std::cout << std::endl << "Tuned configuration: " << (tunedOptions.empty() ? "default" : tunedOptions) << std::endl;
+    if(settings.verificationGames == 0)
+        return 0;
+
+    const Benchmark::MatchScore score = Benchmark::get_match_score(Benchmark::play_match(players, settings.verificationGames, settings.threads, settings.openingMoves, settings.seed * 1000u + settings.rounds));
+    std::cout << std::setprecision(1) << "Tuned against starting configuration, " << settings.verificationGames << " games: "
+              << score.wins << " wins, " << score.draws << " draws, " << score.losses << " losses, "
+              << "Elo " << Benchmark::elo_difference(score.score)
+              << " [" << Benchmark::elo_difference(score.score - score.margin) << ", " << Benchmark::elo_difference(score.score + score.margin) << "]" << std::endl;
+    const std::string bestOptions = (score.score >= 0.5) ? tunedOptions : startOptions;
+    std::cout << "Best configuration: " << (bestOptions.empty() ? "default" : bestOptions) << std::endl;
+    return 0;
+}
@@ -0,0 +1,96 @@
+#include "wide_game.hpp"
+
+#include <ostream>
+
+namespace Benchmark {
+
+    long WideGame::_instanceCount = 0;
+
+    namespace {
+        //splitmix64 finalizer
+        uint64_t mix(uint64_t value) {
+            value += 0x9E3779B97F4A7C15ull;
+            value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+            value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+            return value ^ (value >> 31);
+        }
+
+        //map a hash to [-1, 1]
+        float to_unit(uint64_t hash) {
+            return static_cast<float>(hash >> 40) / static_cast<float>(1ull << 23) - 1.0f;
+        }
+    }
+
+    WideGame::WideGame(unsigned int branching, unsigned int depth, uint64_t seed) {
+        _branching = branching;
+        _depth = depth;
+        _ply = 0;
+        _hash = mix(seed);
+        _sum = 0;
+        ++_instanceCount;
+    }
+
+    WideGame::WideGame(const WideGame* parent, unsigned int index) {
+        _branching = parent->_branching;
+        _depth = parent->_depth;
+        _ply = parent->_ply + 1;
+        _hash = parent->move_hash(index);
+        //first player adds, second player subtracts
+        _sum = parent->_sum + ((parent->_ply % 2 == 0) ? 1.0f : -1.0f) * parent->get_move_value(index);
+        ++_instanceCount;
+    }
+
+    WideGame::~WideGame() {
+        --_instanceCount;
+    }
+
+    long WideGame::get_instance_count() {
+        return _instanceCount;
+    }
+
+    float WideGame::get_score() const {
+        if(_sum > 0)
+            return 1;
+        else if(_sum < 0)
+            return 0;
+        return 0.5;
+    }
+
+    bool WideGame::is_game_over() const {
+        return _ply >= _depth;
+    }
+
+    unsigned int WideGame::get_move_count() const {
+        return is_game_over() ? 0 : _branching;
+    }
+
+    WideGame* WideGame::do_move(unsigned int index) {
+        return new WideGame(this, index);
+    }
+
+    uint64_t WideGame::move_hash(unsigned int index) const {
+        return mix(_hash ^ (static_cast<uint64_t>(index) << 32 | index));
+    }
+
+    float WideGame::get_move_value(unsigned int index) const {
+        return to_unit(move_hash(index));
+    }
+
+    size_t WideGame::get_memory_size() const {
+        return sizeof(WideGame);
+    }
+
+    unsigned int WideGame::get_player_to_move() const {
+        return _ply % 2;
+    }
+
+    float WideGame::get_move_prior(unsigned int index) const {
+        //the true value blurred by an independent noise of the same amplitude
+        return get_move_value(index) + to_unit(mix(move_hash(index)));
+    }
+
+    void WideGame::show(std::ostream& os) const {
+        os << "WideGame ply " << _ply << "/" << _depth << " sum " << _sum << std::endl;
+    }
+
+} /* Benchmark */
@@ -0,0 +1,92 @@
+#ifndef MCTS_BENCHMARK_WIDE_GAME_CLASS_HPP
+#define MCTS_BENCHMARK_WIDE_GAME_CLASS_HPP
+
+#include "game_state.hpp"
+
+#include <cstdint>
+
+namespace Benchmark {
+
+    /**
+     * \brief   Synthetic game with a large constant branching factor
+     * \details Each move carries a pseudo random value in [-1, 1], derived from the hash of the move sequence.
+     *          The players alternate adding (first player) and subtracting (second player) the values of their moves,
+     *          the first player wins if the sum is positive after a fixed number of plies.
+     */
+    class WideGame :
+        public MCTS::IGame_State
+    {
+        public:
+            /**
+             * \param[in] branching Moves available in every position
+             * \param[in] depth     Plies of a full game
+             * \param[in] seed      Seed of the move values
+             */
+            WideGame(unsigned int branching, unsigned int depth, uint64_t seed);
+
+            /**
+             * \brief Implementation of the get_score function of the IGame_State interface
+             */
+            virtual float get_score() const;
+
+            /**
+             * \brief Implementation of the is_game_over function of the IGame_State interface
+             */
+            virtual bool is_game_over() const;
+
+            /**
+             * \brief Implementation of the get_move_count function of the IGame_State interface
+             */
+            virtual unsigned int get_move_count() const;
+
+            /**
+             * \brief Implementation of the do_move function of the IGame_State interface
+             */
+            virtual WideGame* do_move(unsigned int index);
+
+            /**
+             * \brief Implementation of the get_move_prior function of the IGame_State interface: the move value, with noise
+             */
+            virtual float get_move_prior(unsigned int index) const;
+
+            /**
+             * \brief Implementation of the get_memory_size function of the IGame_State interface
+             */
+            virtual size_t get_memory_size() const;
+
+            /**
+             * \brief Implementation of the get_player_to_move function of the IGame_State interface: the second player subtracts its move values
+             */
+            virtual unsigned int get_player_to_move() const;
+
+            /**
+             * \brief Return the value of a move, for the player making it
+             */
+            float get_move_value(unsigned int index) const;
+
+            /**
+             * \brief Count of WideGame objects alive
+             */
+            static long get_instance_count();
+
+            virtual ~WideGame();
+
+        private:
+            WideGame(const WideGame* parent, unsigned int index);
+
+            virtual void show(std::ostream& os) const;
+
+            uint64_t move_hash(unsigned int index) const;
+
+            unsigned int _branching;
+            unsigned int _depth;
+            unsigned int _ply;
+            uint64_t _hash;
+            float _sum;
+
+            static long _instanceCount;
+    };
+
+} /* Benchmark */
+
+#endif
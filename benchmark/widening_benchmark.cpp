@@ -0,0 +1,90 @@
+#include "benchmarks.hpp"
+#include "wide_game.hpp"
+
+#include "MCTS.hpp"
+
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace Benchmark {
+
+    namespace {
+
+        const unsigned int branching = 250;
+        const unsigned int gameDepth = 30;
+
+        struct WideningResult {
+            unsigned int nodeCount;
+            unsigned int maxDepth;
+            double meanDepth;       //mean depth of the nodes
+            double treeBytes;       //estimated heap size of the tree
+            double seconds;
+            float bestMoveValue;    //value of the chosen root move
+        };
+
+        WideningResult measure_widening(unsigned int seed, const MCTS::SearchConfig& config, unsigned int iterations) {
+            WideningResult result = {0, 0, 0.0, 0.0, 0.0, 0.0f};
+            WideGame* root = new WideGame(branching, gameDepth, seed);
+
+            MCTS::seed_random(seed);
+            MCTS::MCTS tree(root, config);
+
+            Timer timer;
+            const unsigned int bestMove = tree.search_best_move(iterations);
+            result.seconds = timer.elapsed_seconds();
+            result.bestMoveValue = root->get_move_value(bestMove);
+
+            const TreeShape shape = measure_tree_shape(tree.get_root(), sizeof(WideGame));
+            result.nodeCount = shape.nodeCount;
+            result.maxDepth = shape.maxDepth;
+            result.meanDepth = shape.meanDepth;
+            result.treeBytes = shape.treeBytes;
+            return result;
+        }
+
+    }
+
+    int run_widening_benchmark(int argc, char** argv) {
+        const unsigned int iterations = get_argument(argc, argv, 1, 20000);
+        const unsigned int games = get_argument(argc, argv, 2, 5);
+
+        struct Mode {
+            const char* name;
+            MCTS::SearchConfig config;
+        };
+        std::vector<Mode> modes(3);
+        modes[0].name = "full expansion";
+        modes[1].name = "widening";
+        modes[1].config.useProgressiveWidening = true;
+        modes[2].name = "widening + prior";
+        modes[2].config.useProgressiveWidening = true;
+        modes[2].config.useMovePriorOrder = true;
+
+        std::cout << "Wide synthetic game (" << branching << " moves, " << gameDepth << " plies), "
+            << games << " games, " << iterations << " iterations" << std::endl;
+        std::cout << std::fixed << std::setprecision(2);
+        std::cout << "mode             | nodes   | max depth | mean depth | tree MB     | iterations/s | root move value" << std::endl;
+        for(const Mode& mode : modes) {
+            WideningResult sum = {0, 0, 0.0, 0.0, 0.0, 0.0f};
+            for(unsigned int game = 0; game < games; ++game) {
+                const WideningResult result = measure_widening(game + 1, mode.config, iterations);
+                sum.nodeCount += result.nodeCount;
+                sum.maxDepth += result.maxDepth;
+                sum.meanDepth += result.meanDepth;
+                sum.treeBytes += result.treeBytes;
+                sum.seconds += result.seconds;
+                sum.bestMoveValue += result.bestMoveValue;
+            }
+            std::cout << std::left << std::setw(16) << mode.name << std::right
+                << " | " << std::setw(7) << sum.nodeCount / games
+                << " | " << std::setw(9) << static_cast<double>(sum.maxDepth) / games
+                << " | " << std::setw(10) << sum.meanDepth / games
+                << " | " << std::setw(11) << sum.treeBytes / games / 1e6
+                << " | " << std::setw(12) << static_cast<unsigned int>(iterations * games / sum.seconds)
+                << " | " << std::setw(15) << sum.bestMoveValue / games << std::endl;
+        }
+        return 0;
+    }
+
+} /* Benchmark */
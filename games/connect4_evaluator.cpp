@@ -0,0 +1,85 @@
+#include "connect4_evaluator.hpp"
+#include "puissance4.hpp"
+
+#include <cmath>
+#include <cstdlib>
+
+//weight of a line holding 1, 2 or 3 tokens of a single player
+#define LINE_WEIGHT_1 1.0f
+#define LINE_WEIGHT_2 4.0f
+#define LINE_WEIGHT_3 16.0f
+//line weight difference giving a value of 0.73
+#define VALUE_SCALE 24.0f
+
+namespace MCTS {
+
+    Connect4Evaluator::Connect4Evaluator(bool withPriors) :
+        _withPriors(withPriors)
+    {
+        const int width = Puissance4::_boardWidth;
+        const int height = Puissance4::_boardHeight;
+
+        unsigned int line = 0;
+        const int directions[4][2] = {{1, 0}, {0, 1}, {1, 1}, {1, -1}};
+        for(int x = 0; x < width; ++x) {
+            for(int y = 0; y < height; ++y) {
+                for(const auto& direction : directions) {
+                    const int endX = x + 3 * direction[0];
+                    const int endY = y + 3 * direction[1];
+                    if(endX < 0 or endX >= width or endY < 0 or endY >= height)
+                        continue;
+                    for(int k = 0; k < 4; ++k)
+                        _lines[line][k] = (x + k * direction[0]) * height + (y + k * direction[1]);
+                    line += 1;
+                }
+            }
+        }
+    }
+
+    void Connect4Evaluator::evaluate(const std::vector<const IGame_State*>& states, std::vector<float>& values, std::vector<std::vector<float>>* priors) {
+        values.resize(states.size());
+        for(unsigned int i = 0; i < states.size(); ++i)
+            values[i] = this->evaluate_state(states[i]);
+
+        if(priors == nullptr)
+            return;
+        priors->resize(states.size());
+        for(unsigned int i = 0; i < states.size(); ++i) {
+            std::vector<float>& statePriors = (*priors)[i];
+            statePriors.resize(states[i]->get_move_count());
+            for(unsigned int move = 0; move < statePriors.size(); ++move) {
+                const int column = states[i]->get_move_id(move);
+                statePriors[move] = 4.0f - std::abs(column - static_cast<int>(Puissance4::_boardWidth / 2));
+            }
+        }
+    }
+
+    bool Connect4Evaluator::has_priors() const {
+        return _withPriors;
+    }
+
+    float Connect4Evaluator::evaluate_state(const IGame_State* state) const {
+        const Puissance4* game = static_cast<const Puissance4*>(state);
+        const float weights[4] = {0.0f, LINE_WEIGHT_1, LINE_WEIGHT_2, LINE_WEIGHT_3};
+
+        std::array<int, Puissance4::_boardWidth * Puissance4::_boardHeight> cells;
+        for(unsigned int x = 0; x < Puissance4::_boardWidth; ++x)
+            for(unsigned int y = 0; y < Puissance4::_boardHeight; ++y)
+                cells[x * Puissance4::_boardHeight + y] = game->get_board_at(x, y);
+
+        float balance = 0.0f;
+        for(const std::array<unsigned int, 4>& line : _lines) {
+            int xTokens = 0, oTokens = 0;
+            for(unsigned int cell : line) {
+                xTokens += (cells[cell] > 0) ? 1 : 0;
+                oTokens += (cells[cell] < 0) ? 1 : 0;
+            }
+            if(oTokens == 0)
+                balance += weights[std::min(xTokens, 3)];
+            else if(xTokens == 0)
+                balance -= weights[std::min(oTokens, 3)];
+        }
+        return 1.0f / (1.0f + std::exp(-balance / VALUE_SCALE));
+    }
+
+} /* MCTS */
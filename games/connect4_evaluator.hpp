@@ -0,0 +1,61 @@
+#ifndef MCTS_GAME_CONNECT4_EVALUATOR_CLASS_HPP
+#define MCTS_GAME_CONNECT4_EVALUATOR_CLASS_HPP
+
+#include "leaf_evaluator.hpp"
+
+#include <array>
+#include <vector>
+
+/**
+ * \file    connect4_evaluator.hpp
+ * \author  Baptiste Hudyma
+ * \version 1.0
+ * \date    11 mars 2021
+ *
+ * \brief   Heuristic Connect 4 evaluator, a CPU stand-in for a learned evaluator
+ */
+
+namespace MCTS {
+
+    /**
+     * \brief   Evaluate Puissance4 states by their open lines of four
+     * \details Each line of four cells holding tokens of a single player counts for this player, more for more tokens.
+     *          The difference of the two players counts gives the value through a logistic function.
+     *          The move priors favour the central columns. Every evaluated state must be a Puissance4.
+     */
+    class Connect4Evaluator :
+        public ILeaf_Evaluator
+    {
+        public:
+            /**
+             * \param[in] withPriors True to also return the central column priors
+             */
+            explicit Connect4Evaluator(bool withPriors = false);
+
+            /**
+             * \brief Implementation of the evaluate function of the ILeaf_Evaluator interface
+             */
+            virtual void evaluate(const std::vector<const IGame_State*>& states, std::vector<float>& values, std::vector<std::vector<float>>* priors);
+
+            /**
+             * \brief Implementation of the has_priors function of the ILeaf_Evaluator interface
+             */
+            virtual bool has_priors() const;
+
+            /**
+             * \brief Heuristic value of a single state
+             *
+             * \return The expected score of X, in ]0, 1[
+             */
+            float evaluate_state(const IGame_State* state) const;
+
+        private:
+            static const unsigned int _lineCount = 69;
+
+            bool _withPriors;
+            std::array<std::array<unsigned int, 4>, _lineCount> _lines;    //cells of every line of four
+    };
+
+} /* MCTS */
+
+#endif
@@ -0,0 +1,279 @@
+#ifndef MCTS_GAME_CONNECT_K_CLASS_HPP
+#define MCTS_GAME_CONNECT_K_CLASS_HPP
+
+#include "game_state.hpp"
+
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <type_traits>
+
+/**
+ * \file    connect_k.hpp
+ * \author  Baptiste Hudyma
+ * \version 1.0
+ * \date    11 mars 2021
+ *
+ * \brief   N-in-a-row gravity games (Connect 4 and its variants) with compile time board dimensions
+ */
+
+namespace MCTS {
+
+    /**
+     * \brief   Narrowest unsigned integer type with at least Bits bits
+     */
+    template<unsigned int Bits>
+    using BitboardType =
+        std::conditional_t<(Bits <= 16), uint16_t,
+        std::conditional_t<(Bits <= 32), uint32_t,
+        std::conditional_t<(Bits <= 64), uint64_t,
+        unsigned __int128>>>;
+
+    /**
+     * \brief   Board masks of a ConnectK game, computed at compile time
+     */
+    template<unsigned int W, unsigned int H, unsigned int K>
+    struct ConnectKTables {
+        typedef BitboardType<W * H> Board;
+
+        static constexpr unsigned int cellCount = W * H;
+        static constexpr unsigned int lineCount =
+            ((W >= K) ? (W - K + 1) * H : 0) +                          //horizontal
+            ((H >= K) ? W * (H - K + 1) : 0) +                          //vertical
+            ((W >= K and H >= K) ? 2 * (W - K + 1) * (H - K + 1) : 0);  //both diagonals
+        static constexpr unsigned int maxLinesPerCell = 4 * K;
+
+        std::array<Board, lineCount> lines;                                         //every line of K cells
+        std::array<std::array<uint16_t, maxLinesPerCell>, cellCount> cellLines;     //lines crossing each cell
+        std::array<uint8_t, cellCount> cellLineCount;
+        std::array<Board, cellCount> cellBits;                                      //single cell masks
+
+        static constexpr ConnectKTables make() {
+            ConnectKTables tables {};
+            for(unsigned int cell = 0; cell < cellCount; ++cell)
+                tables.cellBits[cell] = static_cast<Board>(Board(1) << cell);
+
+            unsigned int line = 0;
+            auto add_line = [&](int x, int y, int dx, int dy) {
+                Board mask = 0;
+                for(int k = 0; k < static_cast<int>(K); ++k) {
+                    const unsigned int cell = (x + k * dx) * H + (y + k * dy);
+                    mask |= tables.cellBits[cell];
+                    tables.cellLines[cell][tables.cellLineCount[cell]++] = line;
+                }
+                tables.lines[line++] = mask;
+            };
+
+            for(unsigned int x = 0; x < W; ++x) {
+                for(unsigned int y = 0; y < H; ++y) {
+                    const bool fitsRight = x + K <= W;
+                    const bool fitsUp = y + K <= H;
+                    const bool fitsDown = y + 1 >= K;
+                    if(fitsRight)
+                        add_line(x, y, 1, 0);
+                    if(fitsUp)
+                        add_line(x, y, 0, 1);
+                    if(fitsRight and fitsUp)
+                        add_line(x, y, 1, 1);
+                    if(fitsRight and fitsDown)
+                        add_line(x, y, 1, -1);
+                }
+            }
+            return tables;
+        }
+    };
+
+    /**
+     * \brief   Gravity game on a W x H board, won by aligning K tokens
+     * \details Each player tokens are stored in a bitboard, cell (x, y) being bit x * H + y.
+     *          The win lines, the lines crossing each cell and the cell masks are computed at compile time,
+     *          so checking a win after a move only tests the few lines crossing the played cell.
+     *          The first player to move from the empty board plays X, and the score is given from its point of view (like Puissance4).
+     */
+    template<unsigned int W, unsigned int H, unsigned int K>
+    class ConnectK :
+        public IGame_State
+    {
+        static_assert(W * H <= 128, "The board must fit in a 128 bits integer");
+        static_assert(W < 256 and H < 256, "Column heights and moves are stored on 8 bits");
+        static_assert(K >= 2 and (K <= W or K <= H), "A line of K tokens must fit on the board");
+
+        public:
+            typedef BitboardType<W * H> Board;
+
+            static constexpr unsigned int boardWidth = W;
+            static constexpr unsigned int boardHeight = H;
+            static constexpr unsigned int connectLength = K;
+
+            /**
+             * \brief Implementation of the get_score function of the IGame_State interface
+             */
+            virtual float get_score() const {
+                if(_winner < 0)
+                    return 0;
+                else if(_winner == 0)
+                    return 0.5;
+                return 1;
+            }
+
+            /**
+             * \brief Implementation of the is_game_over function of the IGame_State interface
+             */
+            virtual bool is_game_over() const {
+                return _moveCount == 0;
+            }
+
+            /**
+             * \brief Implementation of the get_move_count function of the IGame_State interface
+             */
+            virtual unsigned int get_move_count() const {
+                return _moveCount;
+            }
+
+            /**
+             * \brief Implementation of the do_move function of the IGame_State interface: the index-th playable column, from the left
+             */
+            virtual ConnectK* do_move(unsigned int index) {
+                if(index >= _moveCount)
+                    std::cerr << "Error: index to execute is > to max index: " << index << " " << static_cast<unsigned int>(_moveCount) << std::endl;
+                ConnectK* newGS = new ConnectK(*this);
+                newGS->play_column(_moves[index]);
+                return newGS;
+            }
+
+            /**
+             * \brief Implementation of the get_move_id function of the IGame_State interface: the column of the move
+             */
+            virtual unsigned int get_move_id(unsigned int index) const {
+                return _moves[index];
+            }
+
+            /**
+             * \brief Implementation of the get_memory_size function of the IGame_State interface
+             */
+            virtual size_t get_memory_size() const {
+                return sizeof(ConnectK);
+            }
+
+            /**
+             * \brief Implementation of the get_player_to_move function of the IGame_State interface: 1 when O plays next
+             */
+            virtual unsigned int get_player_to_move() const {
+                return _player;
+            }
+
+            /*
+             *    End of virtual function overload
+             */
+
+            /**
+             * \brief Empty board, X to play
+             */
+            ConnectK() {
+                _boards = {0, 0};
+                _heights.fill(0);
+                for(unsigned int x = 0; x < W; ++x)
+                    _moves[x] = x;
+                _moveCount = W;
+                _player = 0;
+                _winner = 0;
+            }
+
+            ConnectK(const ConnectK& gs) = default;
+
+            virtual ~ConnectK() {}
+
+            /**
+             * \brief Drop a token of the player to move in a column. The column must not be full, and the game not over
+             *
+             * \param[in] column The column, in [0, W[
+             */
+            void play_column(unsigned int column) {
+                const unsigned int cell = column * H + _heights[column];
+                _boards[_player] |= _tables.cellBits[cell];
+                _heights[column] += 1;
+
+                if(this->is_winning_cell(cell)) {
+                    _winner = (_player == 0) ? 1 : -1;
+                    _moveCount = 0;
+                }
+                else if(_heights[column] >= H) {
+                    //column full: remove it, keeping the columns in increasing order
+                    unsigned int i = 0;
+                    while(_moves[i] != column)
+                        ++i;
+                    for(; i + 1 < _moveCount; ++i)
+                        _moves[i] = _moves[i + 1];
+                    _moveCount -= 1;
+                }
+                _player ^= 1;
+            }
+
+            /**
+             * \brief Return the token at a coordinate set
+             *
+             * \return 1 for X (first player), -1 for O, 0 if empty
+             */
+            int get_board_at(unsigned int x, unsigned int y) const {
+                const Board cell = _tables.cellBits[x * H + y];
+                if(_boards[0] & cell)
+                    return 1;
+                if(_boards[1] & cell)
+                    return -1;
+                return 0;
+            }
+
+        protected:
+            /**
+             * \brief Check if the tokens of the player who just played at cell make a line crossing it
+             */
+            bool is_winning_cell(unsigned int cell) const {
+                const Board board = _boards[_player];
+                for(unsigned int i = 0; i < _tables.cellLineCount[cell]; ++i) {
+                    const Board line = _tables.lines[_tables.cellLines[cell][i]];
+                    if((board & line) == line)
+                        return true;
+                }
+                return false;
+            }
+
+        private:
+            typedef ConnectKTables<W, H, K> Tables;
+
+            static constexpr Tables _tables = Tables::make();
+
+            /**
+             * \brief Implementation of the show function of the IGame_State interface
+             */
+            virtual void show(std::ostream& os) const {
+                for(unsigned int y = H; y > 0; y--) {
+                    for(unsigned int x = 0; x < W; ++x) {
+                        const int val = get_board_at(x, y - 1);
+                        if(val < 0)
+                            os << " 0 |";
+                        else if(val > 0)
+                            os << " X |";
+                        else
+                            os << "   |";
+                    }
+                    os << std::endl;
+                }
+            }
+
+            //members
+            std::array<Board, 2> _boards;       //tokens of X, then O
+            std::array<uint8_t, W> _heights;    //tokens in each column
+            std::array<uint8_t, W> _moves;      //playable columns, in increasing order
+            uint8_t _moveCount;                 //0 once the game is over
+            uint8_t _player;                    //0 if X plays next, 1 for O
+            int8_t _winner;                     //1 if X won, -1 if O won, 0 otherwise
+    };
+
+    /**
+     * \brief The classic 7x6 Connect 4
+     */
+    typedef ConnectK<7, 6, 4> ConnectFour;
+
+} /* MCTS */
+
+#endif
@@ -0,0 +1,160 @@
+#include "gomoku.hpp"
+
+#include <cstdlib>
+
+namespace MCTS {
+
+    Gomoku::Gomoku() {
+        _board.fill(0);
+        for(unsigned int cell = 0; cell < Gomoku::cellCount; ++cell) {
+            _emptyCells[cell] = cell;
+            _emptyIndex[cell] = cell;
+        }
+        _emptyCount = Gomoku::cellCount;
+        _player = 1;
+        _winner = 0;
+    }
+
+    Gomoku::~Gomoku() {
+
+    }
+
+
+    float Gomoku::get_score() const {
+        if(_winner < 0)
+            return 0;
+        else if(_winner == 0)
+            return 0.5;
+        return 1;
+    }
+
+    bool Gomoku::is_game_over() const {
+        return _winner != 0 or _emptyCount == 0;
+    }
+
+    unsigned int Gomoku::get_move_count() const {
+        if(_winner != 0)
+            return 0;
+        return _emptyCount;
+    }
+
+    Gomoku* Gomoku::do_move(unsigned int index) {
+        if(index >= this->get_move_count())
+            std::cerr << "Error: index to execute is > to max index: " << index << " " << this->get_move_count() << std::endl;
+        Gomoku* newGS = new Gomoku(*this);
+        const unsigned int cell = _emptyCells[index];
+        newGS->play(cell / Gomoku::boardSize, cell % Gomoku::boardSize);
+        return newGS;
+    }
+
+    unsigned int Gomoku::get_move_id(unsigned int index) const {
+        return _emptyCells[index];
+    }
+
+    size_t Gomoku::get_memory_size() const {
+        return sizeof(Gomoku);
+    }
+
+    unsigned int Gomoku::get_player_to_move() const {
+        return (_player < 0) ? 1 : 0;
+    }
+
+    float Gomoku::get_move_prior(unsigned int index) const {
+        const int x = _emptyCells[index] / Gomoku::boardSize;
+        const int y = _emptyCells[index] % Gomoku::boardSize;
+
+        //stones around the cell
+        unsigned int neighbours = 0;
+        for(int dx = -1; dx <= 1; ++dx) {
+            for(int dy = -1; dy <= 1; ++dy) {
+                const int nx = x + dx, ny = y + dy;
+                if(nx >= 0 and ny >= 0 and nx < static_cast<int>(Gomoku::boardSize) and ny < static_cast<int>(Gomoku::boardSize))
+                    neighbours += (_board[nx * Gomoku::boardSize + ny] != 0) ? 1 : 0;
+            }
+        }
+
+        //small center bias to order the cells far from any stone
+        const int center = Gomoku::boardSize / 2;
+        const float distance = std::abs(x - center) + std::abs(y - center);
+        return neighbours - distance / (4.0f * Gomoku::boardSize);
+    }
+
+    void Gomoku::play(unsigned int x, unsigned int y) {
+        const unsigned int cell = x * Gomoku::boardSize + y;
+        _board[cell] = _player;
+
+        //remove the cell from the empty list: move the last empty cell in its place
+        const unsigned int index = _emptyIndex[cell];
+        const unsigned int lastCell = _emptyCells[_emptyCount - 1];
+        _emptyCells[index] = lastCell;
+        _emptyIndex[lastCell] = index;
+        _emptyCount -= 1;
+
+        if(this->is_winning_cell(cell))
+            _winner = _player;
+        _player = -_player;
+    }
+
+    unsigned int Gomoku::get_move_index(unsigned int x, unsigned int y) const {
+        if(x >= Gomoku::boardSize or y >= Gomoku::boardSize)
+            return this->get_move_count();
+        const unsigned int cell = x * Gomoku::boardSize + y;
+        if(_board[cell] != 0)
+            return this->get_move_count();
+        return _emptyIndex[cell];
+    }
+
+    int Gomoku::get_board_at(unsigned int x, unsigned int y) const {
+        return _board[x * Gomoku::boardSize + y];
+    }
+
+    unsigned int Gomoku::count_direction(int x, int y, int dx, int dy, int8_t color) const {
+        unsigned int count = 0;
+        x += dx;
+        y += dy;
+        while(count < Gomoku::winLength and x >= 0 and y >= 0 and x < static_cast<int>(Gomoku::boardSize) and y < static_cast<int>(Gomoku::boardSize)
+                and _board[x * Gomoku::boardSize + y] == color) {
+            count += 1;
+            x += dx;
+            y += dy;
+        }
+        return count;
+    }
+
+    bool Gomoku::is_winning_cell(unsigned int cell) const {
+        const int x = cell / Gomoku::boardSize;
+        const int y = cell % Gomoku::boardSize;
+        const int8_t color = _board[cell];
+
+        static const int directions[4][2] = {{1, 0}, {0, 1}, {1, 1}, {1, -1}};
+        for(const auto& direction : directions) {
+            const unsigned int length = 1 +
+                count_direction(x, y, direction[0], direction[1], color) +
+                count_direction(x, y, -direction[0], -direction[1], color);
+            if(length >= Gomoku::winLength)
+                return true;
+        }
+        return false;
+    }
+
+    void Gomoku::show(std::ostream& os) const {
+        os << "   ";
+        for(unsigned int y = 0; y < Gomoku::boardSize; ++y)
+            os << (y % 10) << " ";
+        os << std::endl;
+        for(unsigned int x = 0; x < Gomoku::boardSize; ++x) {
+            os << (x < 10 ? " " : "") << x << " ";
+            for(unsigned int y = 0; y < Gomoku::boardSize; ++y) {
+                const int val = get_board_at(x, y);
+                if(val < 0)
+                    os << "0 ";
+                else if(val > 0)
+                    os << "X ";
+                else
+                    os << ". ";
+            }
+            os << std::endl;
+        }
+    }
+
+} /* MCTS */
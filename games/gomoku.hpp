@@ -0,0 +1,128 @@
+#ifndef MCTS_GAME_GOMOKU_CLASS_HPP
+#define MCTS_GAME_GOMOKU_CLASS_HPP
+
+#include "game_state.hpp"
+
+#include <array>
+#include <cstdint>
+#include <iostream>
+
+namespace MCTS {
+
+    /**
+     * \brief   15x15 Gomoku: the first player to align five stones or more wins
+     * \details The empty cells are kept in a list updated in O(1) on each move, and a win is only checked around the last stone.
+     *          The first player to move from the empty board plays X, and the score is given from its point of view.
+     */
+    class Gomoku :
+        public IGame_State
+    {
+        public:
+            static const unsigned int boardSize = 15;
+            static const unsigned int cellCount = boardSize * boardSize;
+            static const unsigned int winLength = 5;
+
+            /**
+             * \brief Implementation of the get_score function of the IGame_State interface
+             */
+            virtual float get_score() const;
+
+            /**
+             * \brief Implementation of the is_game_over function of the IGame_State interface
+             */
+            virtual bool is_game_over() const;
+
+            /**
+             * \brief Implementation of the get_move_count function of the IGame_State interface
+             */
+            virtual unsigned int get_move_count() const;
+
+            /**
+             * \brief Implementation of the do_move function of the IGame_State interface
+             */
+            virtual Gomoku* do_move(unsigned int index);
+
+            /**
+             * \brief Implementation of the get_move_id function of the IGame_State interface: the cell of the move
+             */
+            virtual unsigned int get_move_id(unsigned int index) const;
+
+            /**
+             * \brief Implementation of the get_memory_size function of the IGame_State interface
+             */
+            virtual size_t get_memory_size() const;
+
+            /**
+             * \brief Implementation of the get_player_to_move function of the IGame_State interface: 1 when O plays next
+             */
+            virtual unsigned int get_player_to_move() const;
+
+            /**
+             * \brief Implementation of the get_move_prior function of the IGame_State interface: favors cells next to stones and the center
+             */
+            virtual float get_move_prior(unsigned int index) const;
+
+            /*
+             *    End of virtual function overload
+             */
+
+            /**
+             * \brief Empty board, X to play
+             */
+            Gomoku();
+
+            Gomoku(const Gomoku& gs) = default;
+
+            virtual ~Gomoku();
+
+            /**
+             * \brief Place a stone of the player to move. The cell must be empty, and the game not over
+             *
+             * \param[in] x
+             * \param[in] y
+             */
+            void play(unsigned int x, unsigned int y);
+
+            /**
+             * \brief Return the index of the move playing a cell
+             *
+             * \return The move index, or get_move_count() if the cell is not playable
+             */
+            unsigned int get_move_index(unsigned int x, unsigned int y) const;
+
+            /**
+             * \brief Return the stone at a coordinate set
+             *
+             * \return 1 for X, -1 for O, 0 if empty
+             */
+            int get_board_at(unsigned int x, unsigned int y) const;
+
+        protected:
+            /**
+             * \brief Check if the stone at cell is part of a line of winLength stones
+             */
+            bool is_winning_cell(unsigned int cell) const;
+
+            /**
+             * \brief Count the consecutive stones of a color from (x, y) excluded, in the direction (dx, dy)
+             */
+            unsigned int count_direction(int x, int y, int dx, int dy, int8_t color) const;
+
+        private:
+            /**
+             * \brief Implementation of the show function of the IGame_State interface
+             */
+            virtual void show(std::ostream& os) const;
+
+            //members
+            std::array<int8_t, cellCount> _board;           //1 for X, -1 for O, 0 if empty
+            std::array<uint8_t, cellCount> _emptyCells;     //playable cells, the move indexes
+            std::array<uint8_t, cellCount> _emptyIndex;     //position of each empty cell in _emptyCells
+            uint8_t _emptyCount;
+            int8_t _player;                                 //color of the player to move
+            int8_t _winner;                                 //1 if X won, -1 if O won, 0 otherwise
+    };
+
+} /* MCTS */
+
+#endif
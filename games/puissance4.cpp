@@ -10,12 +10,12 @@ namespace MCTS {
     }
 
     Puissance4::Puissance4(const Puissance4* gs) {
-        for(unsigned int index = 0; index < Puissance4::_boardWidth * Puissance4::_boardHeight; ++index) {
-            _board[index] = gs->_board[index];
-        }
+        _board = gs->_board;
         _turn = 1 - gs->_turn;
         _winner = 0;
-        this->fill_moves();
+        //same board: same moves, updated by set_board_at
+        _nextMoves = gs->_nextMoves;
+        _nextMoveCount = gs->_nextMoveCount;
     }
     Puissance4::~Puissance4() {
 
@@ -38,12 +38,12 @@ namespace MCTS {
     }
 
     unsigned int Puissance4::get_move_count() const {
-        return _nextMoves.size();
+        return _nextMoveCount;
     }
 
     Puissance4* Puissance4::do_move(unsigned int index) {
         if(index >= this->get_move_count())
-            std::cerr << "Error: index to execute is > to max index: " << index << " " << _nextMoves.size() << std::endl;
+            std::cerr << "Error: index to execute is > to max index: " << index << " " << _nextMoveCount << std::endl;
         Puissance4* newGS = new Puissance4(this);
         Index move = _nextMoves[index];
         newGS->set_board_at(move.x, move.y);
@@ -51,15 +51,70 @@ namespace MCTS {
         return newGS;
     }
 
+    unsigned int Puissance4::get_move_id(unsigned int index) const {
+        return _nextMoves[index].x;
+    }
+
+    size_t Puissance4::get_memory_size() const {
+        return sizeof(Puissance4);
+    }
+
+    unsigned int Puissance4::get_player_to_move() const {
+        return _turn;
+    }
+
+    unsigned int Puissance4::get_canonical_move(unsigned int index) const {
+        const unsigned int mirrorX = Puissance4::_boardWidth - 1 - _nextMoves[index].x;
+        if(mirrorX >= _nextMoves[index].x or not this->is_mirror_symmetric())
+            return index;
+
+        //moves are sorted by column: the mirrored column comes first
+        for(unsigned int i = 0; i < index; ++i) {
+            if(_nextMoves[i].x == mirrorX)
+                return i;
+        }
+        return index;
+    }
+
+    float Puissance4::get_move_prior(unsigned int index) const {
+        const int x = _nextMoves[index].x;
+        const int y = _nextMoves[index].y;
+        const int width = Puissance4::_boardWidth;
+        const int height = Puissance4::_boardHeight;
+
+        //lines of four of each direction (horizontal, vertical, diagonals) holding the cell
+        const int directions[4][2] = {{1, 0}, {0, 1}, {1, 1}, {1, -1}};
+        unsigned int lineCount = 0;
+        for(const int* direction : directions) {
+            for(int start = -3; start <= 0; ++start) {
+                const int firstX = x + start * direction[0], firstY = y + start * direction[1];
+                const int lastX = firstX + 3 * direction[0], lastY = firstY + 3 * direction[1];
+                if(std::min(firstX, lastX) >= 0 and std::max(firstX, lastX) < width and std::min(firstY, lastY) >= 0 and std::max(firstY, lastY) < height)
+                    lineCount += 1;
+            }
+        }
+        return 0.25f * lineCount;
+    }
+
+    bool Puissance4::is_mirror_symmetric() const {
+        for(unsigned int x = 0; x < Puissance4::_boardWidth / 2; ++x) {
+            const unsigned int mirrorX = Puissance4::_boardWidth - 1 - x;
+            for(unsigned int y = 0; y < Puissance4::_boardHeight; ++y) {
+                if(this->get_board_at(x, y) != this->get_board_at(mirrorX, y))
+                    return false;
+            }
+        }
+        return true;
+    }
+
     void Puissance4::fill_moves() {
-        _nextMoves.clear();
-        _nextMoves.reserve(Puissance4::_boardWidth);
+        _nextMoveCount = 0;
 
         for(unsigned int x = 0; x < Puissance4::_boardWidth; ++x) {
             //each line starting at the bottom
             for(unsigned int y = 0; y < Puissance4::_boardHeight; ++y) {
                 if(this->get_board_at(x, y) == 0) {
-                    _nextMoves.push_back(Index(x, y));
+                    _nextMoves[_nextMoveCount++] = Index(x, y);
                     break;
                 }
             }
@@ -67,6 +122,34 @@ namespace MCTS {
 
     }
 
+    void Puissance4::update_column_moves(unsigned int x) {
+        //lowest empty cell of the column, _boardHeight if full
+        unsigned int y = 0;
+        while(y < Puissance4::_boardHeight and this->get_board_at(x, y) != 0)
+            ++y;
+
+        //position of this column in the moves, kept by increasing column
+        unsigned int index = 0;
+        while(index < _nextMoveCount and _nextMoves[index].x < x)
+            ++index;
+        const bool isListed = index < _nextMoveCount and _nextMoves[index].x == x;
+
+        if(y < Puissance4::_boardHeight) {
+            if(not isListed) {
+                for(unsigned int i = _nextMoveCount; i > index; --i)
+                    _nextMoves[i] = _nextMoves[i - 1];
+                _nextMoveCount += 1;
+            }
+            _nextMoves[index] = Index(x, y);
+        }
+        else if(isListed) {
+            //column is now full
+            for(unsigned int i = index; i + 1 < _nextMoveCount; ++i)
+                _nextMoves[i] = _nextMoves[i + 1];
+            _nextMoveCount -= 1;
+        }
+    }
+
     bool Puissance4::is_full() {
         for(unsigned int x = 0; x < Puissance4::_boardWidth; ++x) {
             for(unsigned int y = 0; y < Puissance4::_boardHeight; ++y) {
@@ -163,7 +246,8 @@ namespace MCTS {
         }
         _board[x * Puissance4::_boardHeight + y] = _turn * 2 - 1;  //-1 to 1
         _winner = get_winner(x, y);
-        this->fill_moves();
+        //a token only changes the move of its column
+        this->update_column_moves(x);
     }
     int Puissance4::get_board_at(unsigned int x, unsigned int y) const {
         if(x >= Puissance4::_boardWidth or y >= Puissance4::_boardHeight) {
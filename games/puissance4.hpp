@@ -1,10 +1,10 @@
 #ifndef MCTS_GAME_PUISSANCE_QUATRE_CLASS_HPP
+#define MCTS_GAME_PUISSANCE_QUATRE_CLASS_HPP
 
 #include "game_state.hpp"
 
 #include <iostream>
 #include <array>
-#include <vector>
 
 namespace MCTS {
 
@@ -33,6 +33,31 @@ namespace MCTS {
              */
             virtual Puissance4* do_move(unsigned int index);
 
+            /**
+             * \brief Implementation of the get_move_id function of the IGame_State interface: the column of the move
+             */
+            virtual unsigned int get_move_id(unsigned int index) const;
+
+            /**
+             * \brief Implementation of the get_memory_size function of the IGame_State interface
+             */
+            virtual size_t get_memory_size() const;
+
+            /**
+             * \brief Implementation of the get_player_to_move function of the IGame_State interface: 1 when O plays next
+             */
+            virtual unsigned int get_player_to_move() const;
+
+            /**
+             * \brief Implementation of the get_canonical_move function of the IGame_State interface: the mirrored column, on a left-right symmetric board
+             */
+            virtual unsigned int get_canonical_move(unsigned int index) const;
+
+            /**
+             * \brief Implementation of the get_move_prior function of the IGame_State interface: a quarter of the lines of four through the cell of the move, favoring the center
+             */
+            virtual float get_move_prior(unsigned int index) const;
+
             /*
              *    End of virtual function overload
              */
@@ -52,10 +77,28 @@ namespace MCTS {
             void set_board_at(unsigned int x, unsigned int y);
             void set_turn(int turn);
 
+            /**
+             * \brief Return the value of the game board at a coordinate set
+             *
+             * \param[in] x
+             * \param[in] y
+             *
+             * \return The value at [x, y] in the board: 1 for X (first player), -1 for O, 0 if empty
+             */
+            int get_board_at(unsigned int x, unsigned int y) const;
+
+            static const unsigned int _boardHeight = 6;
+            static const unsigned int _boardWidth = 7;
+
         protected:
 
             bool is_full(); //board is full
 
+            /**
+             * \brief Check if the board is unchanged by a left-right mirror
+             */
+            bool is_mirror_symmetric() const;
+
             /**
              * \brief Calculates the winner of this game from this position
              *
@@ -65,17 +108,15 @@ namespace MCTS {
              * \return 1 if O won, -1 if X won, 0 if nobody won yet
              */
             int get_winner(int x, int y) const; 
+
+            void fill_moves();
+
             /**
-             * \brief Return the value of the game board at a coordinate set
-             *
-             * \param[in] x
-             * \param[in] y
+             * \brief Update the move of a single column after a token was placed in it
              *
-             * \return The value at [x, y] in the board
+             * \param[in] x The column that changed
              */
-            int get_board_at(unsigned int x, unsigned int y) const;
-
-            void fill_moves();
+            void update_column_moves(unsigned int x);
 
 
         private:
@@ -84,6 +125,8 @@ namespace MCTS {
                 unsigned int x;
                 unsigned int y;
 
+                Index() : x(0), y(0) {}
+
                 Index(unsigned int _x, unsigned int _y) {
                     x = _x;
                     y = _y;
@@ -95,13 +138,11 @@ namespace MCTS {
              */
             virtual void show(std::ostream& os) const; 
 
-            static const unsigned int _boardHeight = 6;
-            static const unsigned int _boardWidth = 7;
-
 
             //members
             std::array<int, Puissance4::_boardWidth * Puissance4::_boardHeight> _board;
-            std::vector<Index> _nextMoves;
+            std::array<Index, Puissance4::_boardWidth> _nextMoves;  //lowest empty cell of each non full column, by increasing column
+            unsigned int _nextMoveCount;
             int _turn;
             int _winner;
 
@@ -25,12 +25,12 @@ namespace MCTS {
     }
 
     unsigned int Game_State::get_move_count() const {
-        return _nextMoves.size();
+        return _nextMoveCount;
     }
 
     Game_State* Game_State::do_move(unsigned int index) {
         if(index >= this->get_move_count())
-            std::cerr << "Error: index to execute is > to max index: " << index << " " << _nextMoves.size() << std::endl;
+            std::cerr << "Error: index to execute is > to max index: " << index << " " << _nextMoveCount << std::endl;
         Game_State* newGS = new Game_State(this);
         Index move = _nextMoves[index];
         newGS->set_board_at(move.x, move.y);
@@ -38,6 +38,56 @@ namespace MCTS {
         return newGS;
     }
 
+    unsigned int Game_State::get_move_id(unsigned int index) const {
+        const Index& move = _nextMoves[index];
+        return move.x * 3 + move.y;
+    }
+
+    size_t Game_State::get_memory_size() const {
+        return sizeof(Game_State);
+    }
+
+    unsigned int Game_State::get_player_to_move() const {
+        return _turn;
+    }
+
+    unsigned int Game_State::get_canonical_move(unsigned int index) const {
+        const Index& move = _nextMoves[index];
+        unsigned int canonicalCell = move.x * 3 + move.y;
+        for(unsigned int symmetry = 1; symmetry < 8; ++symmetry) {
+            const unsigned int cell = Game_State::get_symmetric_cell(symmetry, move.x, move.y);
+            if(cell >= canonicalCell)
+                continue;
+
+            //only the symmetries keeping the board unchanged
+            bool isInvariant = true;
+            for(unsigned int i = 0; i < 9 and isInvariant; ++i)
+                isInvariant = _board[i] == _board[Game_State::get_symmetric_cell(symmetry, i / 3, i % 3)];
+            if(isInvariant)
+                canonicalCell = cell;
+        }
+
+        //moves are in board order: the canonical cell is listed before this one
+        for(unsigned int i = 0; i < index; ++i) {
+            if(_nextMoves[i].x * 3 + _nextMoves[i].y == canonicalCell)
+                return i;
+        }
+        return index;
+    }
+
+    unsigned int Game_State::get_symmetric_cell(unsigned int symmetry, unsigned int x, unsigned int y) {
+        switch(symmetry) {
+            case 1: return y * 3 + (2 - x);             //rotations
+            case 2: return (2 - x) * 3 + (2 - y);
+            case 3: return (2 - y) * 3 + x;
+            case 4: return (2 - x) * 3 + y;             //mirrors
+            case 5: return x * 3 + (2 - y);
+            case 6: return y * 3 + x;                   //diagonals
+            case 7: return (2 - y) * 3 + (2 - x);
+            default: return x * 3 + y;
+        }
+    }
+
     /**
      * End of interface overloading
      *
@@ -51,13 +101,13 @@ namespace MCTS {
         this->fill_moves();
     }
     Game_State::Game_State(const Game_State* gs) {
-        for(unsigned int i = 0; i < 9; ++i)
-            _board[i] = gs->_board[i];
+        _board = gs->_board;
         _turn = 1 - gs->_turn;
-        this->fill_moves();
+        //same board: same moves, updated by set_board_at
+        _nextMoves = gs->_nextMoves;
+        _nextMoveCount = gs->_nextMoveCount;
     }
     Game_State::~Game_State() {
-        _nextMoves.clear();
     }
 
 
@@ -66,7 +116,7 @@ namespace MCTS {
     }
 
     void Game_State::fill_moves() {
-        _nextMoves.clear();
+        _nextMoveCount = 0;
 
         if(not this->is_game_over()) {
             //no winner/loser yer
@@ -74,7 +124,7 @@ namespace MCTS {
             for(unsigned int x = 0; x < 3; ++x) {
                 for(unsigned int y = 0; y < 3; ++y) {
                     if(this->get_board_at(x, y) == 0) {   //no move on this cell
-                        _nextMoves.push_back(Index(x, y));
+                        _nextMoves[_nextMoveCount++] = Index(x, y);
                     }
                 }
             }
@@ -82,6 +132,25 @@ namespace MCTS {
         }
     }
 
+    void Game_State::remove_move(unsigned int x, unsigned int y) {
+        if(this->get_winner() != 0) {
+            //no more moves once the game is won
+            _nextMoveCount = 0;
+            return;
+        }
+
+        unsigned int index = 0;
+        while(index < _nextMoveCount and (_nextMoves[index].x != x or _nextMoves[index].y != y))
+            ++index;
+        if(index >= _nextMoveCount)
+            return;
+
+        //keep the board order of the remaining moves
+        for(; index + 1 < _nextMoveCount; ++index)
+            _nextMoves[index] = _nextMoves[index + 1];
+        _nextMoveCount -= 1;
+    }
+
     bool Game_State::is_full() const {
         for(int i = 0; i < 9; ++i) {
             if(_board[i] == 0)
@@ -97,7 +166,7 @@ namespace MCTS {
             return;
         }
         _board[x * 3 + y] = _turn * 2 - 1;  //-1 to 1
-        this->fill_moves();
+        this->remove_move(x, y);
     }
     int Game_State::get_board_at(unsigned int x, unsigned int y) const {
         return _board[x * 3 + y];
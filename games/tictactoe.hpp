@@ -1,10 +1,10 @@
 #ifndef MCTS_GAME_TICTACTOE_CLASS_HPP
+#define MCTS_GAME_TICTACTOE_CLASS_HPP
 
 #include "game_state.hpp"
 
 #include <iostream>
 #include <array>
-#include <vector>
 
 namespace MCTS {
 
@@ -12,6 +12,8 @@ namespace MCTS {
         unsigned int x;
         unsigned int y;
 
+        Index() : x(0), y(0) {}
+
         Index(unsigned int _x, unsigned int _y) {
             x = _x;
             y = _y;
@@ -46,6 +48,26 @@ namespace MCTS {
              */
             virtual Game_State* do_move(unsigned int index);
 
+            /**
+             * \brief Implementation of the get_move_id function of the IGame_State interface: the cell of the move
+             */
+            virtual unsigned int get_move_id(unsigned int index) const;
+
+            /**
+             * \brief Implementation of the get_memory_size function of the IGame_State interface
+             */
+            virtual size_t get_memory_size() const;
+
+            /**
+             * \brief Implementation of the get_player_to_move function of the IGame_State interface: 1 when O plays next
+             */
+            virtual unsigned int get_player_to_move() const;
+
+            /**
+             * \brief Implementation of the get_canonical_move function of the IGame_State interface: the lowest cell among the images of the cell by the 8 board symmetries keeping the board unchanged
+             */
+            virtual unsigned int get_canonical_move(unsigned int index) const;
+
             /**
               * \brief Default constructor. Create an empty 3x3 grid, 0 starts
               *
@@ -72,9 +94,21 @@ namespace MCTS {
         protected:
             void fill_moves();
 
+            /**
+              * \brief Remove a played cell from the moves, and all the moves if the game is won
+              */
+            void remove_move(unsigned int x, unsigned int y);
+
 
             bool is_full() const; //board is full
 
+            /**
+              * \brief Return the cell (x * 3 + y) at the image of a cell by one of the 8 board symmetries
+              *
+              * \param[in] symmetry Index of the symmetry in [0, 8[, 0 being the identity
+              */
+            static unsigned int get_symmetric_cell(unsigned int symmetry, unsigned int x, unsigned int y);
+
             /**
               * \brief Return the value of the game board at a coordinate set
               *
@@ -125,7 +159,8 @@ namespace MCTS {
 
             //members
             std::array<int, 9> _board;
-            std::vector<Index> _nextMoves;
+            std::array<Index, 9> _nextMoves;    //empty cells, in board order
+            unsigned int _nextMoveCount;
             int _turn;   //1 if i play, 0 if he plays
 
     };
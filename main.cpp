@@ -1,22 +1,24 @@
 #include <iostream>
+#include <string>
 
 #include "MCTS.hpp"
 
 #include "tictactoe.hpp"
 #include "puissance4.hpp"
+#include "gomoku.hpp"
 
 
 
-void play_tictactoe(bool shouldStart = false) {
+void play_tictactoe(const MCTS::SearchConfig& config, bool shouldStart = false) {
     MCTS::Game_State* currentState = new MCTS::Game_State();
 
     if(shouldStart)
         currentState->set_board_at(0, 1);
 
     while(1) {
-        MCTS::MCTS monteCarloTreeSearch(currentState);
+        MCTS::MCTS monteCarloTreeSearch(currentState, config);
 
-        unsigned int bestIndex = monteCarloTreeSearch.search_best_move(300);
+        unsigned int bestIndex = monteCarloTreeSearch.search_best_move();
         std::cout << "nodes visited : " << monteCarloTreeSearch.get_visits() << " with a score of " << monteCarloTreeSearch.get_score() << std::endl;
 
         currentState = currentState->do_move(bestIndex); 
@@ -43,30 +45,71 @@ void play_tictactoe(bool shouldStart = false) {
     }
 }
 
-void play_connect4(bool shouldStart = false) {
-    MCTS::Puissance4* currentState = new MCTS::Puissance4();
+void play_connect4(const MCTS::SearchConfig& config, bool shouldStart = false) {
+    MCTS::Puissance4* initialState = new MCTS::Puissance4();
     if(shouldStart)
-        currentState->set_board_at(3, 0);
+        initialState->set_board_at(3, 0);
 
+    //the tree is kept between moves, and keeps searching during the opponent turn
+    MCTS::MCTS monteCarloTreeSearch(initialState, config);
     while(1) {
-        MCTS::MCTS monteCarloTreeSearch(currentState);
-
-        unsigned int bestIndex = monteCarloTreeSearch.search_best_move(1000000);
+        unsigned int bestIndex = monteCarloTreeSearch.search_best_move();
         std::cout << "nodes visited : " << monteCarloTreeSearch.get_visits() << " with a score of " << monteCarloTreeSearch.get_score() << std::endl;
         monteCarloTreeSearch.show_best_path(10);
         monteCarloTreeSearch.show_best_moves(10);
 
-        currentState = currentState->do_move(bestIndex); 
+        monteCarloTreeSearch.advance_root(bestIndex);
+        const MCTS::IGame_State* currentState = monteCarloTreeSearch.get_root()->_state;
 
         std::cout << currentState << std::endl;
         if(currentState->is_game_over())
             break;
 
+        monteCarloTreeSearch.ponder();
+
         int nextMoveX = -1;
         std::cin >> nextMoveX;
 
-        currentState = currentState->do_move(nextMoveX);
+        monteCarloTreeSearch.advance_root(nextMoveX);
+        currentState = monteCarloTreeSearch.get_root()->_state;
+        std::cout << currentState << std::endl;
+
+        if(currentState->is_game_over()) {
+            std::cout << currentState << std::endl;
+            break;
+        }
+    }
+}
+
+
+
+void play_gomoku(const MCTS::SearchConfig& config) {
+    MCTS::MCTS monteCarloTreeSearch(new MCTS::Gomoku(), config);
+    while(1) {
+        unsigned int bestIndex = monteCarloTreeSearch.search_best_move();
+        std::cout << "nodes visited : " << monteCarloTreeSearch.get_visits() << " with a score of " << monteCarloTreeSearch.get_score() << std::endl;
+
+        monteCarloTreeSearch.advance_root(bestIndex);
+        const MCTS::Gomoku* currentState = static_cast<const MCTS::Gomoku*>(monteCarloTreeSearch.get_root()->_state);
+
         std::cout << currentState << std::endl;
+        if(currentState->is_game_over())
+            break;
+
+        monteCarloTreeSearch.ponder();
+
+        //line and column of the next stone
+        unsigned int moveIndex = currentState->get_move_count();
+        while(moveIndex >= currentState->get_move_count()) {
+            int nextMoveX = -1;
+            int nextMoveY = -1;
+            if(not (std::cin >> nextMoveX >> nextMoveY))
+                return;
+            moveIndex = currentState->get_move_index(nextMoveX, nextMoveY);
+        }
+
+        monteCarloTreeSearch.advance_root(moveIndex);
+        currentState = static_cast<const MCTS::Gomoku*>(monteCarloTreeSearch.get_root()->_state);
 
         if(currentState->is_game_over()) {
             std::cout << currentState << std::endl;
@@ -77,10 +120,67 @@ void play_connect4(bool shouldStart = false) {
 
 
 
+void show_usage(const char* program) {
+    std::cout << "Usage: " << program << " [--game connect4|tictactoe|gomoku] [search options]" << std::endl;
+    MCTS::show_search_options(std::cout);
+}
+
+
+
 int main(int argc, char** argv) {
+    std::string game = "connect4";
+    for(int i = 1; i + 1 < argc; ++i) {
+        if(std::string(argv[i]) == "--game")
+            game = argv[i + 1];
+    }
+
+    //default budget of each game, replaced by the command line options
+    MCTS::SearchConfig config;
+    if(game == "connect4") {
+        config.iterationsPerMove = 1000000;
+    }
+    else if(game == "tictactoe") {
+        config.iterationsPerMove = 300;
+    }
+    else if(game == "gomoku") {
+        //more than 200 moves per node: only expand the most promising ones
+        config.iterationsPerMove = 50000;
+        config.useProgressiveWidening = true;
+        config.useMovePriorOrder = true;
+    }
+    else {
+        show_usage(argv[0]);
+        return 1;
+    }
+
+    for(int i = 1; i < argc; ++i) {
+        const std::string option = argv[i];
+        if(option.rfind("--", 0) != 0) {
+            show_usage(argv[0]);
+            return 1;
+        }
+        if(option == "--game") {
+            i += 1;
+            continue;
+        }
+
+        const std::string name = option.substr(2);
+        std::string value;
+        if(not MCTS::is_search_flag(name) and i + 1 < argc)
+            value = argv[++i];
+        if(not MCTS::set_search_option(config, name, value)) {
+            std::cerr << "Invalid option " << option << " " << value << std::endl;
+            show_usage(argv[0]);
+            return 1;
+        }
+    }
 
-    play_connect4();
-    //play_tictactoe();
+    if(game == "connect4")
+        play_connect4(config);
+    else if(game == "tictactoe")
+        play_tictactoe(config);
+    else
+        play_gomoku(config);
 
     //monteCarloTreeSearch.show_best_moves(10);
     //monteCarloTreeSearch.show_best_path(10);
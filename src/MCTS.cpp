@@ -1,6 +1,16 @@
 #include "MCTS.hpp"
+#include "random.hpp"
+#include "tree_reclaimer.hpp"
 
+#include <algorithm>
 #include <iostream>
+#include <limits>
+
+//iterations between two checks of the stop flag and best move snapshots
+#define BACKGROUND_SEARCH_BATCH 256
+
+//iterations between two checks of the deadline of a timed search
+#define DEADLINE_CHECK_INTERVAL 64
 
 namespace MCTS {
 
@@ -9,8 +19,22 @@ namespace MCTS {
      *
      *
      */
-    MCTS::MCTS(IGame_State* initialGameState) {
+    MCTS::MCTS(IGame_State* initialGameState, const SearchConfig& config) :
+        _config(config),
+        _stopRequested(false),
+        _isSearching(false),
+        _bestMoveSnapshot(0),
+        _lastSearchStats({0, 0, 0, false}),
+        _stableBestChild(nullptr),
+        _stableSinceIteration(0),
+        _nodeCount(1),
+        _isNodeCountKnown(true),
+        _searchStartResidentBytes(0),
+        _hasQueuedTrees(false)
+    {
         _root = new Node(initialGameState);    
+        if(_config.randomSeed != 0)
+            seed_random(_config.randomSeed);
     }
 
 
@@ -21,45 +45,321 @@ namespace MCTS {
      *
      */
     unsigned int MCTS::search_best_move(unsigned int iterations) {
-        //at least one iteration
-        do {
-            Node* currentNode = this->get_UCT_leaf();
-            if(currentNode != nullptr) {
-                float endScore = currentNode->rollout();
-                currentNode->backpropagate(endScore);
-                //currentNode->rollout_expand();
-            }
-            else {
-                //reached a closed node
-                //break;
+        return this->finish_search(this->run_search(iterations, std::chrono::steady_clock::time_point::max()));
+    }
+
+    unsigned int MCTS::search_best_move() {
+        const unsigned int iterations = (_config.iterationsPerMove == 0) ? std::numeric_limits<unsigned int>::max() : _config.iterationsPerMove;
+        std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+        if(_config.moveTimeMilliseconds != 0)
+            deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(_config.moveTimeMilliseconds);
+        return this->finish_search(this->run_search(iterations, deadline));
+    }
+
+    unsigned int MCTS::search_best_move_until(std::chrono::steady_clock::time_point deadline, unsigned int iterations) {
+        const Node* bestChild = this->run_search((iterations == 0) ? std::numeric_limits<unsigned int>::max() : iterations, deadline);
+        if(bestChild == nullptr)
+            return 0;
+        _bestMoveSnapshot = bestChild->get_move_index();
+        return bestChild->get_move_index();
+    }
+
+    unsigned int MCTS::search_best_move(TimeManager& timeManager) {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        const double baseBudget = timeManager.start_move();
+        const std::chrono::steady_clock::time_point deadline = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double, std::milli>(baseBudget));
+        const Node* bestChild = this->run_search(std::numeric_limits<unsigned int>::max(), deadline, &timeManager, start);
+        timeManager.end_move(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+
+        if(bestChild == nullptr)
+            return 0;
+        _bestMoveSnapshot = bestChild->get_move_index();
+        return bestChild->get_move_index();
+    }
+
+    Node* MCTS::run_search(unsigned int iterations, std::chrono::steady_clock::time_point deadline, TimeManager* timeManager, std::chrono::steady_clock::time_point moveStart) {
+        this->stop();
+        _searchStartResidentBytes = start_resident_window();
+
+        //at least one iteration, while first node is not closed
+        const unsigned int budget = std::max(1u, iterations);
+        const bool hasDeadline = deadline != std::chrono::steady_clock::time_point::max();
+        _lastSearchStats = {budget, 0, 0, false};
+        if(not _config.useEarlyStop and not hasDeadline) {
+            _lastSearchStats.iterations = this->run_iterations(budget);
+        }
+        else {
+            _stableBestChild = nullptr;
+            _stableSinceIteration = 0;
+            unsigned int done = 0;
+            unsigned int nextStopCheck = std::max(1u, _config.earlyStopCheckInterval);
+            //the deadline is checked at least every DEADLINE_CHECK_INTERVAL iterations, whatever the early stop interval
+            unsigned int checkInterval = hasDeadline ? DEADLINE_CHECK_INTERVAL : nextStopCheck;
+            if(_config.useEarlyStop)
+                checkInterval = std::min(checkInterval, nextStopCheck);
+            while(done < budget and not _root->is_closed()) {
+                done += this->run_iterations(std::min(checkInterval, budget - done));
+
+                //the time manager budget changes with the root visits, the deadline follows it
+                if(timeManager != nullptr)
+                    deadline = moveStart + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double, std::milli>(timeManager->get_move_budget(_root)));
+                if(hasDeadline and std::chrono::steady_clock::now() >= deadline)
+                    break;
+                if(_config.useEarlyStop and done >= nextStopCheck and done < budget) {
+                    nextStopCheck = done + std::max(1u, _config.earlyStopCheckInterval);
+                    if(this->should_stop_early(budget - done, done)) {
+                        //an unbounded budget saves no iteration
+                        _lastSearchStats.savedIterations = (budget == std::numeric_limits<unsigned int>::max()) ? 0 : budget - done;
+                        _lastSearchStats.stoppedEarly = true;
+                        break;
+                    }
+                }
             }
-            iterations -= 1;
-        } while (iterations != 0 and not _root->is_closed());
-        //while first node is not closed
+            _lastSearchStats.iterations = done;
+        }
+
+        //the early stop rules bound the visits: play the move they settled, unless a fully explored child has the best exact value,
+        //as closed children are not visited anymore (an immediate win has a single visit)
+        if(_config.useEarlyStop) {
+            Node* bestChild = _root->get_best_child();
+            if(bestChild != nullptr and bestChild->is_closed())
+                return bestChild;
+            return _root->get_most_visited_child();
+        }
+        //return index with best UCB
+        return _root->get_best_child();
+    }
 
-        if(iterations <= 0)
+    unsigned int MCTS::finish_search(const Node* bestChild) {
+        if(_root->is_closed())
             std::cout << "Parsed until the end" << std::endl;
         
-        //return index with best UCB
-       Node* bestChild = this->get_best_move();
         if(bestChild == nullptr) {
             std::cerr << "Best child of root is null" << std::endl;
             return 0;
         }
+        _bestMoveSnapshot = bestChild->get_move_index();
         return bestChild->get_move_index();
     }
 
+    const SearchStats& MCTS::get_last_search_stats() const {
+        return _lastSearchStats;
+    }
+
+    void MCTS::set_config(const SearchConfig& config) {
+        this->stop();
+        _config = config;
+        if(_config.randomSeed != 0)
+            seed_random(_config.randomSeed);
+    }
+
+    const SearchConfig& MCTS::get_config() const {
+        return _config;
+    }
+
+    TreeStats MCTS::tree_stats() {
+        this->stop();
+        return compute_tree_stats(_root, _searchStartResidentBytes);
+    }
+
+    size_t MCTS::export_tree(const std::string& path, ExportFormat format, const ExportFilter& filter) {
+        this->stop();
+        TreeExporter exporter(filter);
+        return exporter.export_tree(_root, format, path);
+    }
+
+    bool MCTS::should_stop_early(unsigned int remainingIterations, unsigned int doneIterations) {
+        Node* bestChild = _root->get_most_visited_child();
+        if(bestChild == nullptr)
+            return false;
+
+        //best move did not change for a window of iterations
+        if(bestChild != _stableBestChild) {
+            _stableBestChild = bestChild;
+            _stableSinceIteration = doneIterations;
+        }
+        else if(_config.earlyStopStableWindow > 0 and doneIterations - _stableSinceIteration >= _config.earlyStopStableWindow) {
+            return true;
+        }
+
+        //an unexplored move could still become the best
+        if(not _root->is_fully_expanded())
+            return false;
+
+        const unsigned int mostVisits = bestChild->get_visit_count();
+        unsigned int secondVisits = 0;
+        for(const Node* child : _root->get_children()) {
+            if(child != bestChild)
+                secondVisits = std::max(secondVisits, child->get_visit_count());
+        }
+
+        //the most visited child is played: stop once the others can not catch it
+        return mostVisits - secondVisits > remainingIterations;
+    }
+
+    unsigned int MCTS::run_iterations(unsigned int iterations) {
+        unsigned int done = 0;
+        while(done < iterations and not _root->is_closed()) {
+            this->run_iteration();
+            done += 1;
+        }
+        return done;
+    }
+
+    void MCTS::start_search(unsigned int iterations) {
+        this->stop();
+
+        _searchStartResidentBytes = start_resident_window();
+        _stopRequested = false;
+        _isSearching = true;
+        _searchThread = std::thread(&MCTS::background_search, this, iterations);
+    }
+
+    void MCTS::ponder() {
+        this->start_search(0);
+    }
+
+    void MCTS::stop() {
+        _stopRequested = true;
+        if(_searchThread.joinable())
+            _searchThread.join();
+    }
+
+    bool MCTS::is_searching() const {
+        return _isSearching;
+    }
+
+    unsigned int MCTS::best_move_so_far() const {
+        return _bestMoveSnapshot;
+    }
+
+    void MCTS::advance_root(unsigned int moveIndex) {
+        this->stop();
+
+        Node* newRoot = _root->detach_child(moveIndex);
+        //the buffers still hold the nodes of the new root
+        this->release_tree(_root, std::vector<NodeBuffer>());
+        _root = newRoot;
+        _isNodeCountKnown = false;
+
+        //the new root may live in a compaction buffer: the buffers are released by the next compaction
+        if(_config.compactOnAdvance)
+            this->compact(_config.treeLayout);
+
+        _bestMoveSnapshot = 0;
+        this->update_best_move_snapshot();
+    }
+
+    void MCTS::compact(TreeLayout layout) {
+        this->stop();
+
+        const size_t nodeCount = _root->count_nodes();
+        NodeBuffer buffer(static_cast<Node*>(::operator new(nodeCount * sizeof(Node))));
+        _root = _root->relayout(buffer.get(), layout);
+        _nodeCount = nodeCount;
+        _isNodeCountKnown = true;
+
+        //every node was moved out of the previous buffers, but a discarded tree queued for reclamation may still be in them
+        this->release_tree(nullptr, std::move(_nodeBuffers));
+        _nodeBuffers.clear();
+        _nodeBuffers.push_back(std::move(buffer));
+    }
+
+    void MCTS::release_tree(Node* root, std::vector<NodeBuffer>&& buffers) {
+        if(_config.reclaimInBackground) {
+            _hasQueuedTrees = true;
+            TreeReclaimer::get_shared().reclaim(root, std::move(buffers));
+            return;
+        }
+        if(root != nullptr)
+            Node::destroy(root);
+        //reclaimInBackground may have been set when a discarded tree with nodes in these buffers was queued
+        if(_hasQueuedTrees and not buffers.empty())
+            TreeReclaimer::get_shared().wait_idle();
+        buffers.clear();
+    }
+
+    void MCTS::background_search(unsigned int iterations) {
+        if(_config.randomSeed != 0)
+            seed_random(_config.randomSeed);
+
+        unsigned int done = 0;
+        while(not _stopRequested and not _root->is_closed() and (iterations == 0 or done < iterations)) {
+            unsigned int batch = BACKGROUND_SEARCH_BATCH;
+            if(iterations != 0)
+                batch = std::min(batch, iterations - done);
+            done += this->run_iterations(batch);
+            this->update_best_move_snapshot();
+        }
+        _isSearching = false;
+    }
+
+    void MCTS::update_best_move_snapshot() {
+        Node* bestChild = _root->get_best_child();
+        if(bestChild != nullptr)
+            _bestMoveSnapshot = bestChild->get_move_index();
+    }
+
+
+    void MCTS::run_iteration() {
+        Node* currentNode = this->get_UCT_leaf();
+        if(currentNode == nullptr) {
+            //reached a closed node
+            return;
+        }
+        _nodeCount += 1;
+
+        const unsigned int expansions = this->get_rollout_expansion_count();
+        if(expansions > 0) {
+            //keep the first moves of the rollout in the tree
+            Node* lastNode = currentNode->rollout_expand(_config, expansions);
+            for(const Node* node = lastNode; node != currentNode; node = node->get_parent())
+                _nodeCount += 1;
+            currentNode = lastNode;
+        }
+
+        if(_config.useRave) {
+            _rolloutMoves.clear();
+            float endScore = currentNode->rollout(&_rolloutMoves);
+            currentNode->backpropagate(endScore);
+            currentNode->backpropagate_amaf(endScore, _rolloutMoves);
+        }
+        else {
+            float endScore = currentNode->rollout();
+            currentNode->backpropagate(endScore);
+        }
+    }
+
+    unsigned int MCTS::get_rollout_expansion_count() {
+        if(_config.rolloutExpansionNodes == 0 or _config.rolloutExpansionNodeBudget == 0)
+            return _config.rolloutExpansionNodes;
+
+        if(not _isNodeCountKnown) {
+            _nodeCount = _root->count_nodes();
+            _isNodeCountKnown = true;
+        }
+        if(_nodeCount >= _config.rolloutExpansionNodeBudget)
+            return 0;
+        return std::min<size_t>(_config.rolloutExpansionNodes, _config.rolloutExpansionNodeBudget - _nodeCount);
+    }
+
 
     Node* MCTS::get_UCT_leaf() {
         Node* currentNode = _root;
         while(not currentNode->is_game_over()) {
             //while node not an end game leaf
             
-            if(not currentNode->is_fully_expanded()) { 
+            if(currentNode->can_expand(_config)) { 
                 //at least a move can be made here, do it
-                return currentNode->expand_children();
+                return currentNode->expand_children(_config);
+            }
+
+            Node* bestChild = currentNode->get_best_child_UCT(_config);
+            if(bestChild == nullptr) {
+                //every expanded child is closed (widen past the progressive widening limit), or the next move is more urgent
+                return currentNode->expand_children(_config);
             }
-            currentNode = currentNode->get_best_child_UCT();
+            currentNode = bestChild;
         }
         //never reached an end node, should never happen 
         return nullptr;
@@ -67,20 +367,28 @@ namespace MCTS {
 
 
     Node* MCTS::get_best_move() {
+        this->stop();
         return _root->get_best_child();
     }
 
     void MCTS::show_tree(unsigned int maxDepth) {
+        this->stop();
         _root->show_node(maxDepth, 0);
     }
     void MCTS::show_best_path(unsigned int maxDepth) {
+        this->stop();
         _root->show_best_node(maxDepth, 0);
     }
     void MCTS::show_best_moves(unsigned int maxDepth) {
+        this->stop();
         _root->show_best_moves(maxDepth, 0);
     }
 
 
+    const Node* MCTS::get_root() const {
+        return _root;
+    }
+
     unsigned int MCTS::get_visits() const {
         return _root->get_visit_count();
     }
@@ -90,7 +398,8 @@ namespace MCTS {
 
 
     MCTS::~MCTS() {
-        delete _root;
+        this->stop();
+        this->release_tree(_root, std::move(_nodeBuffers));
     }
 
 };  //MCTS
@@ -2,7 +2,19 @@
 #define MCTS_MCTS_TREE_CLASS_HPP
 
 #include "game_state.hpp"
+#include "leaf_evaluator.hpp"
 #include "node.hpp"
+#include "search_config.hpp"
+#include "time_manager.hpp"
+#include "tree_exporter.hpp"
+#include "tree_stats.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
 
 /**
  * \file   MCTS.hpp
@@ -16,6 +28,30 @@
 
 namespace MCTS {
 
+    /**
+     * \brief   Activity of the pipelined search stages
+     * \details A stage utilization is the fraction of its threads time spent working rather than waiting on a queue
+     */
+    struct PipelineStats {
+        unsigned int iterations;
+        double seconds;
+        unsigned int selectionThreads;
+        unsigned int rolloutThreads;
+        double selectionUtilization;
+        double rolloutUtilization;
+        double backpropagationUtilization;
+    };
+
+    /**
+     * \brief   Statistics of the last search_best_move call
+     */
+    struct SearchStats {
+        unsigned int budget;            //iterations requested
+        unsigned int iterations;        //iterations run
+        unsigned int savedIterations;   //iterations left when an early stop rule ended the search, 0 for an unbounded budget
+        bool stoppedEarly;
+    };
+
     /**
      *
      *
@@ -26,24 +62,170 @@ namespace MCTS {
         public:
 
             /**
-             *
+             * \param[in] initialGameState The root game state, owned by the tree
+             * \param[in] config           The search options
              */
-            MCTS(IGame_State* initialGameState); 
+            MCTS(IGame_State* initialGameState, const SearchConfig& config = SearchConfig()); 
 
             /**
-             * \brief Search for the action that maximises the tree score
+             * \brief Search for the action that maximises the tree score. Stops any background search first.
              *
-             * \param[in] timeLimit Maximum search time (in seconds)
+             * \param[in] iterations Number of iterations to run
              *
              * \return Index of the best action, corresponding to an index in initialGameState
              */
             unsigned int search_best_move(unsigned int iterations);
 
-            //return the first best move in children 
+            /**
+             * \brief Search for the action that maximises the tree score, within the SearchConfig::iterationsPerMove and SearchConfig::moveTimeMilliseconds budget
+             *
+             * \return Index of the best action, corresponding to an index in initialGameState
+             */
+            unsigned int search_best_move();
+
+            /**
+             * \brief   Search for the action that maximises the tree score until a deadline, stopping any background search first
+             * \details The deadline is checked every few dozen iterations. Unlike search_best_move, a closed root is not reported on the standard output
+             *
+             * \param[in] deadline    Time at which the search stops
+             * \param[in] iterations  Iteration budget, 0 for no limit
+             *
+             * \return Index of the best action, corresponding to an index in initialGameState
+             */
+            unsigned int search_best_move_until(std::chrono::steady_clock::time_point deadline, unsigned int iterations = 0);
+
+            /**
+             * \brief   Search for the action that maximises the tree score, on the budget given by a game clock
+             * \details Starts a move of the time manager, moves the search deadline as the time manager adjusts the budget
+             *          to the root visits, then stops the move clock. The tree root must be the position of the move.
+             *
+             * \param[in] timeManager Game clock of the searching player
+             *
+             * \return Index of the best action, corresponding to an index in initialGameState
+             */
+            unsigned int search_best_move(TimeManager& timeManager);
+
+            /**
+             * \return The statistics of the last search_best_move call
+             */
+            const SearchStats& get_last_search_stats() const;
+
+            /**
+             * \brief Change the search options, stopping any background search first. The tree is kept
+             */
+            void set_config(const SearchConfig& config);
+
+            const SearchConfig& get_config() const;
+
+            /**
+             * \brief Report the shape and memory use of the tree, stopping any background search first
+             * \details Walks every node, without recursion. The resident memory peak is the one since the last search started
+             *          (search_best_move*, start_search, ponder). TreeStats::write_json exports the report
+             */
+            TreeStats tree_stats();
+
+            /**
+             * \brief Stream the tree to a JSON or DOT file through a TreeExporter, stopping any background search first
+             *
+             * \param[in] path    Path of the file, replaced if it exists
+             * \param[in] format  File format
+             * \param[in] filter  Nodes to export
+             *
+             * \return The number of exported nodes, 0 if the file could not be written
+             */
+            size_t export_tree(const std::string& path, ExportFormat format, const ExportFilter& filter = ExportFilter());
+
+            /**
+             * \brief   Search for the best action with the pipelined search, stopping any background search first
+             * \details Selection threads pick leaves (with virtual loss) and queue them for the rollout threads, which queue
+             *          their rewards for a single backpropagation thread. Selection and backpropagation take turns on the tree,
+             *          rollouts only read their leaf game state. Thread counts and queue depth come from the SearchConfig.
+             *
+             * \param[in] iterations  Number of simulations to run
+             * \param[out] stats      If not null, receives the stages activity
+             *
+             * \return Index of the best action, corresponding to an index in initialGameState
+             */
+            unsigned int search_best_move_pipeline(unsigned int iterations, PipelineStats* stats = nullptr);
+
+            /**
+             * \brief   Search for the best action, evaluating the leaves by batches instead of with random rollouts, stopping any background search first
+             * \details Up to SearchConfig::evaluationBatchSize leaves are selected, a virtual loss keeping the selections apart,
+             *          then evaluated by a single evaluator call and backpropagated. Game over leaves are backpropagated right away.
+             *          The evaluator priors order the expansion of the leaves children when SearchConfig::useMovePriorOrder is set.
+             *          RAVE is not updated, the evaluator giving no rollout moves.
+             *
+             * \param[in] iterations  Number of leaves to evaluate
+             * \param[in] evaluator   Evaluator of the leaf game states
+             *
+             * \return Index of the best action, corresponding to an index in initialGameState
+             */
+            unsigned int search_best_move_batched(unsigned int iterations, ILeaf_Evaluator& evaluator);
+
+            /**
+             * \brief Run iterations on the tree without choosing a move, on the calling thread
+             *
+             * \param[in] iterations Number of iterations to run
+             *
+             * \return The number of iterations run, lower than iterations if the root closed
+             */
+            unsigned int run_iterations(unsigned int iterations);
+
+            /**
+             * \brief Start searching the tree on a background thread, until stop() is called, the budget is spent or the root is closed
+             *
+             * \param[in] iterations Iteration budget of the search, 0 for no limit
+             */
+            void start_search(unsigned int iterations = 0);
+
+            /**
+             * \brief Keep searching the current tree in the background during the opponent turn.
+             * \details Call advance_root with the opponent reply to stop pondering and keep the matching subtree.
+             */
+            void ponder();
+
+            /**
+             * \brief Stop the background search, and wait for its thread to finish
+             */
+            void stop();
+
+            /**
+             * \return True while a background search is running
+             */
+            bool is_searching() const;
+
+            /**
+             * \brief Thread safe snapshot of the best move, updated by the search between iteration batches
+             *
+             * \return Index of the best action found so far
+             */
+            unsigned int best_move_so_far() const;
+
+            /**
+             * \brief Play a move on the root: stop any background search and keep the subtree of this move as the new tree
+             *
+             * \param[in] moveIndex Index of the move in the current root game state
+             */
+            void advance_root(unsigned int moveIndex);
+
+            /**
+             * \brief Move every node of the tree in a single contiguous buffer
+             * \details Stop any background search. The nodes allocated one by one during the search are scattered in the heap,
+             *          compacting them keeps the descents of the next searches in fewer cache lines and pages.
+             *          Nodes expanded afterwards are allocated as usual.
+             *          A buffer is freed as a whole, by the next compaction or the destruction of the tree: after advance_root
+             *          without SearchConfig::compactOnAdvance, the discarded siblings of the new root are destroyed but their
+             *          memory in the buffer stays allocated until then.
+             *
+             * \param[in] layout Order of the nodes in the buffer
+             */
+            void compact(TreeLayout layout);
+
+            //return the first best move in children, stopping any background search first
             Node* get_best_move();
             
             /**
-              *
+              * \brief Print the tree, stopping any background search first
               *
               *
               */
@@ -51,6 +233,14 @@ namespace MCTS {
             void show_best_path(unsigned int maxDepth);
             void show_best_moves(unsigned int maxDepth);
 
+            /**
+              * \brief Only valid while no background search runs: call stop() first after start_search or ponder
+              *
+              * \return The root node of the tree
+              */
+            const Node* get_root() const;
+
+            //like get_root, only valid while no background search runs
             unsigned int get_visits() const;
             float get_score() const;
 
@@ -66,8 +256,96 @@ namespace MCTS {
               */
             Node* get_UCT_leaf();
 
+            /**
+              * \brief Run a single selection, expansion, rollout and backpropagation step
+              */
+            void run_iteration();
+
+            /**
+              * \brief Body of the background search thread
+              */
+            void background_search(unsigned int iterations);
+
+            /**
+              * \brief Publish the current best move for best_move_so_far
+              */
+            void update_best_move_snapshot();
+
+            /**
+              * \brief Check the early stop rules of the SearchConfig
+              *
+              * \param[in] remainingIterations Iterations left in the budget
+              * \param[in] doneIterations      Iterations already run by this search
+              *
+              * \return True if the remaining iterations can not change the most visited root child, or if it was stable for the window
+              */
+            bool should_stop_early(unsigned int remainingIterations, unsigned int doneIterations);
+
+            /**
+              * \brief Run the iterations of a search, checking the early stop rules and the deadline between chunks of iterations
+              *
+              * \param[in] iterations  Iteration budget
+              * \param[in] deadline    Time at which the search stops, time_point::max() for none
+              * \param[in] timeManager If not null, moves the deadline to moveStart plus its move budget between chunks of iterations
+              * \param[in] moveStart   Start of the move of the time manager
+              *
+              * \return The best child of the root, nullptr if there is none
+              */
+            Node* run_search(unsigned int iterations, std::chrono::steady_clock::time_point deadline, TimeManager* timeManager = nullptr,
+                             std::chrono::steady_clock::time_point moveStart = std::chrono::steady_clock::time_point());
+
+            /**
+              * \brief Report a closed root, and publish the index of the best child of the root
+              *
+              * \param[in] bestChild  Result of run_search
+              *
+              * \return Index of the best action
+              */
+            unsigned int finish_search(const Node* bestChild);
+
+            /**
+              * \brief Free a discarded tree, on the shared TreeReclaimer thread if SearchConfig::reclaimInBackground is set
+              *
+              * \param[in] root     Root of the discarded tree, or nullptr
+              * \param[in] buffers  Compaction buffers to free after the nodes of the discarded trees
+              */
+            void release_tree(Node* root, std::vector<NodeBuffer>&& buffers);
+
+            /**
+              * \brief Run interleaved descents from the root, each one leaving a virtual loss on its path
+              *
+              * \param[in] count   Number of descents
+              * \param[out] leaves Receives the new leaves, fewer than count if some descents found no leaf to expand
+              */
+            void select_leaves_interleaved(unsigned int count, std::vector<Node*>& leaves);
+
+            /**
+              * \brief Number of nodes the next rollout may expand, within SearchConfig::rolloutExpansionNodes and the node budget
+              */
+            unsigned int get_rollout_expansion_count();
+
         private:
             Node* _root;
+            SearchConfig _config;
+
+            std::vector<unsigned int> _rolloutMoves;    //moves of the last rollout, reused between iterations
+
+            //compaction buffers that may still hold nodes of the tree
+            std::vector<NodeBuffer> _nodeBuffers;
+
+            std::thread _searchThread;
+            std::atomic<bool> _stopRequested;
+            std::atomic<bool> _isSearching;
+            std::atomic<unsigned int> _bestMoveSnapshot;
+
+            SearchStats _lastSearchStats;
+            Node* _stableBestChild;             //best child at the last early stop check
+            unsigned int _stableSinceIteration; //iteration where _stableBestChild became the best child
+
+            size_t _nodeCount;                  //nodes of the tree, kept by run_iteration for SearchConfig::rolloutExpansionNodeBudget
+            bool _isNodeCountKnown;             //false once the tree changed outside of run_iteration
+            size_t _searchStartResidentBytes;   //resident memory when the last search started, 0 if unknown
+            bool _hasQueuedTrees;               //a discarded tree was handed to the TreeReclaimer, and may still be freed in the buffers
 
     };
 
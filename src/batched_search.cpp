@@ -0,0 +1,226 @@
+#include "MCTS.hpp"
+
+#include <algorithm>
+#include <coroutine>
+#include <exception>
+#include <iostream>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+/**
+ * \file    batched_search.cpp
+ * \author  Baptiste Hudyma
+ * \version 1.0
+ * \date    11 mars 2021
+ *
+ * \brief   Batched search: leaves are evaluated by groups with an ILeaf_Evaluator instead of random rollouts
+ */
+
+namespace MCTS {
+
+    namespace {
+
+        /**
+         * \brief Coroutine of a single descent, suspended each time it waits for a prefetched node
+         */
+        struct Descent {
+            struct promise_type {
+                Node* leaf = nullptr;       //new leaf, or nullptr if none could be expanded
+                Node* pathEnd = nullptr;    //last node holding the virtual loss of this descent
+
+                Descent get_return_object() { return Descent(std::coroutine_handle<promise_type>::from_promise(*this)); }
+                std::suspend_always initial_suspend() noexcept { return {}; }
+                std::suspend_always final_suspend() noexcept { return {}; }
+                void return_void() {}
+                void unhandled_exception() { std::terminate(); }
+            };
+
+            explicit Descent(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+            Descent(Descent&& other) : handle(std::exchange(other.handle, nullptr)) {}
+            ~Descent() {
+                if(handle)
+                    handle.destroy();
+            }
+
+            std::coroutine_handle<promise_type> handle;
+        };
+
+        /**
+         * \brief Awaitable giving access to the promise of the running descent
+         */
+        struct GetPromise {
+            Descent::promise_type* promise;
+
+            bool await_ready() const noexcept { return false; }
+            bool await_suspend(std::coroutine_handle<Descent::promise_type> handle) noexcept {
+                promise = &handle.promise();
+                return false;
+            }
+            Descent::promise_type* await_resume() const noexcept { return promise; }
+        };
+
+        /**
+         * \brief Same path as MCTS::get_UCT_leaf, adding the virtual loss level by level so that the other descents see it
+         */
+        Descent descend(Node* root, const SearchConfig& config) {
+            Descent::promise_type* promise = co_await GetPromise();
+
+            Node* node = root;
+            node->add_node_virtual_loss();
+            promise->pathEnd = node;
+            while(not node->is_game_over()) {
+                if(node->can_expand(config)) {
+                    promise->leaf = node->expand_children(config);
+                    break;
+                }
+
+                //the UCT reads every child: prefetch the list elements and children one by one, running the other descents meanwhile
+                const std::list<Node*>& children = node->get_children();
+                if(not children.empty()) {
+                    __builtin_prefetch(&*children.begin());
+                    co_await std::suspend_always();
+                }
+                for(auto it = children.begin(); it != children.end(); ++it) {
+                    __builtin_prefetch(*it);
+                    const auto next = std::next(it);
+                    if(next != children.end())
+                        __builtin_prefetch(&*next);
+                    co_await std::suspend_always();
+                }
+
+                Node* bestChild = node->get_best_child_UCT(config);
+                if(bestChild == nullptr) {
+                    //every expanded child is closed (widen past the progressive widening limit), or the next move is more urgent
+                    promise->leaf = node->expand_children(config);
+                    break;
+                }
+                node = bestChild;
+                node->add_node_virtual_loss();
+                promise->pathEnd = node;
+            }
+
+            if(promise->leaf != nullptr) {
+                promise->leaf->add_node_virtual_loss();
+                promise->pathEnd = promise->leaf;
+            }
+        }
+
+    }
+
+    void MCTS::select_leaves_interleaved(unsigned int count, std::vector<Node*>& leaves) {
+        std::vector<Descent> descents;
+        descents.reserve(count);
+        for(unsigned int i = 0; i < count; ++i)
+            descents.push_back(descend(_root, _config));
+
+        //round robin over the running descents
+        unsigned int running = count;
+        while(running > 0) {
+            for(Descent& descent : descents) {
+                if(descent.handle.done())
+                    continue;
+                descent.handle.resume();
+                if(not descent.handle.done())
+                    continue;
+
+                running -= 1;
+                const Descent::promise_type& result = descent.handle.promise();
+                if(result.leaf != nullptr)
+                    leaves.push_back(result.leaf);
+                else
+                    result.pathEnd->revert_virtual_loss();
+            }
+        }
+    }
+
+    unsigned int MCTS::search_best_move_batched(unsigned int iterations, ILeaf_Evaluator& evaluator) {
+        this->stop();
+        _searchStartResidentBytes = start_resident_window();
+        //the nodes expanded here are not counted
+        _isNodeCountKnown = false;
+
+        const unsigned int batchSize = std::max(1u, _config.evaluationBatchSize);
+        const bool usePriors = _config.useMovePriorOrder and evaluator.has_priors();
+
+        std::vector<Node*> leaves;
+        std::vector<const IGame_State*> states;
+        std::vector<float> values;
+        std::vector<std::vector<float>> priors;
+        leaves.reserve(batchSize);
+        states.reserve(batchSize);
+
+        unsigned int done = 0;
+        while(done < iterations and not _root->is_closed()) {
+            const unsigned int batchEnd = std::min(iterations, done + batchSize);
+            leaves.clear();
+            states.clear();
+
+            //selection: the virtual loss of the pending leaves steers the next descents elsewhere
+            if(_config.interleaveDescents) {
+                this->select_leaves_interleaved(batchEnd - done, leaves);
+
+                //game over leaves have a known result, no evaluation needed
+                unsigned int kept = 0;
+                for(Node* leaf : leaves) {
+                    if(leaf->is_game_over()) {
+                        leaf->revert_virtual_loss();
+                        leaf->backpropagate(leaf->get_game_state()->get_score());
+                        done += 1;
+                        continue;
+                    }
+                    leaves[kept++] = leaf;
+                    states.push_back(leaf->get_game_state());
+                }
+                leaves.resize(kept);
+            }
+            else {
+                while(done + leaves.size() < batchEnd and not _root->is_closed()) {
+                    Node* leaf = this->get_UCT_leaf();
+                    if(leaf == nullptr)
+                        break;
+
+                    if(leaf->is_game_over()) {
+                        //known result, no evaluation needed
+                        leaf->backpropagate(leaf->get_game_state()->get_score());
+                        done += 1;
+                        continue;
+                    }
+                    leaf->add_virtual_loss();
+                    leaves.push_back(leaf);
+                    states.push_back(leaf->get_game_state());
+                }
+            }
+            if(leaves.empty()) {
+                if(done < batchEnd)
+                    //no leaf left to select
+                    break;
+                continue;
+            }
+
+            evaluator.evaluate(states, values, usePriors ? &priors : nullptr);
+
+            for(unsigned int i = 0; i < leaves.size(); ++i) {
+                leaves[i]->revert_virtual_loss();
+                if(usePriors)
+                    leaves[i]->set_move_priors(priors[i]);
+                leaves[i]->backpropagate(values[i]);
+            }
+            done += leaves.size();
+        }
+
+        _lastSearchStats.budget = iterations;
+        _lastSearchStats.iterations = done;
+        _lastSearchStats.savedIterations = 0;
+        _lastSearchStats.stoppedEarly = false;
+
+        Node* bestChild = _root->get_best_child();
+        if(bestChild == nullptr) {
+            std::cerr << "Best child of root is null" << std::endl;
+            return 0;
+        }
+        _bestMoveSnapshot = bestChild->get_move_index();
+        return bestChild->get_move_index();
+    }
+
+} /* MCTS */
@@ -0,0 +1,115 @@
+#ifndef MCTS_BOUNDED_QUEUE_CLASS_HPP
+#define MCTS_BOUNDED_QUEUE_CLASS_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * \file    bounded_queue.hpp
+ * \author  Baptiste Hudyma
+ * \version 1.0
+ * \date    11 mars 2021
+ *
+ * \brief   Lock free queue used between the stages of the pipelined search
+ */
+
+namespace MCTS {
+
+    /**
+     * \brief   Bounded multi producer, multi consumer lock free queue
+     * \details Ring buffer of cells tagged with a sequence number (D. Vyukov design): a cell is writable when its sequence
+     *          equals the enqueue position, and readable when it equals the dequeue position + 1.
+     */
+    template<typename T>
+    class BoundedQueue {
+        public:
+            /**
+             * \param[in] capacity Maximum number of queued values, rounded up to a power of two
+             */
+            explicit BoundedQueue(size_t capacity) {
+                size_t size = 2;
+                while(size < capacity)
+                    size *= 2;
+
+                _mask = size - 1;
+                _cells = std::make_unique<Cell[]>(size);
+                for(size_t i = 0; i < size; ++i)
+                    _cells[i].sequence.store(i, std::memory_order_relaxed);
+                _enqueuePosition.store(0, std::memory_order_relaxed);
+                _dequeuePosition.store(0, std::memory_order_relaxed);
+            }
+
+            /**
+             * \return False if the queue is full, value is then left untouched
+             */
+            bool try_push(T&& value) {
+                size_t position = _enqueuePosition.load(std::memory_order_relaxed);
+                while(true) {
+                    Cell& cell = _cells[position & _mask];
+                    const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+                    const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+                    if(difference == 0) {
+                        if(_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                            cell.value = std::move(value);
+                            cell.sequence.store(position + 1, std::memory_order_release);
+                            return true;
+                        }
+                    }
+                    else if(difference < 0)
+                        //full
+                        return false;
+                    else
+                        position = _enqueuePosition.load(std::memory_order_relaxed);
+                }
+            }
+
+            /**
+             * \return False if the queue is empty
+             */
+            bool try_pop(T& value) {
+                size_t position = _dequeuePosition.load(std::memory_order_relaxed);
+                while(true) {
+                    Cell& cell = _cells[position & _mask];
+                    const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+                    const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+                    if(difference == 0) {
+                        if(_dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                            value = std::move(cell.value);
+                            cell.sequence.store(position + _mask + 1, std::memory_order_release);
+                            return true;
+                        }
+                    }
+                    else if(difference < 0)
+                        //empty
+                        return false;
+                    else
+                        position = _dequeuePosition.load(std::memory_order_relaxed);
+                }
+            }
+
+            size_t capacity() const {
+                return _mask + 1;
+            }
+
+        private:
+            BoundedQueue(const BoundedQueue&) = delete;
+            BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+            struct Cell {
+                std::atomic<size_t> sequence;
+                T value;
+            };
+
+            std::unique_ptr<Cell[]> _cells;
+            size_t _mask;
+
+            //on their own cache lines, producers and consumers do not share them
+            alignas(64) std::atomic<size_t> _enqueuePosition;
+            alignas(64) std::atomic<size_t> _dequeuePosition;
+    };
+
+} /* MCTS */
+
+#endif
@@ -0,0 +1,288 @@
+#include "game_record.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+//first bytes of every record file
+#define GAME_RECORD_MAGIC "MCTSGR02"
+#define GAME_RECORD_MAGIC_SIZE 8
+
+//decoded bytes between two releases of the mapped pages
+#define GAME_RECORD_RELEASE_BYTES (16 << 20)
+
+namespace MCTS {
+
+    namespace {
+
+        void write_varint(std::vector<uint8_t>& buffer, unsigned int value) {
+            while(value >= 0x80) {
+                buffer.push_back(static_cast<uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+            buffer.push_back(static_cast<uint8_t>(value));
+        }
+
+        bool read_varint(const uint8_t*& data, const uint8_t* end, unsigned int& value) {
+            value = 0;
+            for(unsigned int shift = 0; shift < 35 and data < end; shift += 7) {
+                const uint8_t byte = *(data++);
+                value |= static_cast<unsigned int>(byte & 0x7F) << shift;
+                if((byte & 0x80) == 0)
+                    return true;
+            }
+            return false;
+        }
+
+        uint8_t quantize(float fraction) {
+            return static_cast<uint8_t>(std::lround(std::min(1.0f, std::max(0.0f, fraction)) * 255.0f));
+        }
+
+    }
+
+    void GameRecord::add_ply(unsigned int move, const std::vector<std::pair<unsigned int, unsigned int>>& visitCounts) {
+        unsigned long long visitSum = 0;
+        for(const std::pair<unsigned int, unsigned int>& child : visitCounts)
+            visitSum += child.second;
+
+        moves.push_back(move);
+        for(const std::pair<unsigned int, unsigned int>& child : visitCounts) {
+            if(child.second > 0)
+                visits.push_back({child.first, quantize(static_cast<float>(child.second) / visitSum)});
+        }
+        visitOffsets.push_back(visits.size());
+    }
+
+    void GameRecord::clear() {
+        score = 0.5f;
+        //the move count is the one of the game, not of the record
+        moves.clear();
+        visitOffsets.assign(1, 0);
+        visits.clear();
+    }
+
+
+
+    GameRecordWriter::GameRecordWriter(const std::string& path) :
+        _file(std::fopen(path.c_str(), "ab")),
+        _writtenBytes(0)
+    {
+        if(_file == nullptr)
+            return;
+
+        //new file: write the magic, existing file: check it
+        if(std::fseek(_file, 0, SEEK_END) == 0 and std::ftell(_file) == 0) {
+            std::fwrite(GAME_RECORD_MAGIC, 1, GAME_RECORD_MAGIC_SIZE, _file);
+            std::fflush(_file);
+            return;
+        }
+        const size_t fileSize = std::ftell(_file);
+        std::FILE* check = std::fopen(path.c_str(), "rb");
+        char magic[GAME_RECORD_MAGIC_SIZE];
+        if(check == nullptr or std::fread(magic, 1, GAME_RECORD_MAGIC_SIZE, check) != GAME_RECORD_MAGIC_SIZE or std::memcmp(magic, GAME_RECORD_MAGIC, GAME_RECORD_MAGIC_SIZE) != 0) {
+            std::fclose(_file);
+            _file = nullptr;
+            if(check != nullptr)
+                std::fclose(check);
+            return;
+        }
+
+        //skip the complete records by their size prefixes: a record cut by a crash would hide the records appended after it
+        size_t recordsEnd = GAME_RECORD_MAGIC_SIZE;
+        uint8_t sizeBytes[4];
+        while(fileSize - recordsEnd >= 4 and std::fread(sizeBytes, 1, 4, check) == 4) {
+            uint32_t payloadSize = 0;
+            for(unsigned int i = 0; i < 4; ++i)
+                payloadSize |= static_cast<uint32_t>(sizeBytes[i]) << (8 * i);
+            if(fileSize - recordsEnd - 4 < payloadSize or std::fseek(check, payloadSize, SEEK_CUR) != 0)
+                break;
+            recordsEnd += 4 + payloadSize;
+        }
+        std::fclose(check);
+
+        if(recordsEnd < fileSize and ftruncate(fileno(_file), recordsEnd) != 0) {
+            std::fclose(_file);
+            _file = nullptr;
+        }
+    }
+
+    GameRecordWriter::~GameRecordWriter() {
+        if(_file != nullptr)
+            std::fclose(_file);
+    }
+
+    bool GameRecordWriter::is_open() const {
+        return _file != nullptr;
+    }
+
+    bool GameRecordWriter::append(const GameRecord& record) {
+        if(_file == nullptr)
+            return false;
+
+        //a move id out of the move count: store the ids
+        unsigned int moveCount = record.moveCount;
+        for(unsigned int move : record.moves)
+            moveCount = (move < moveCount) ? moveCount : 0;
+        for(const MoveVisits& visits : record.visits)
+            moveCount = (visits.move < moveCount) ? moveCount : 0;
+
+        std::vector<uint8_t> buffer(4, 0);     //payload size, set once encoded
+        if(moveCount > 0)
+            buffer.reserve(16 + record.moves.size() * (1 + moveCount));
+        else
+            buffer.reserve(16 + record.moves.size() * 2 + record.visits.size() * 2);
+        write_varint(buffer, record.moves.size());
+        buffer.push_back(quantize(record.score));
+        write_varint(buffer, moveCount);
+        for(size_t ply = 0; ply < record.moves.size(); ++ply) {
+            write_varint(buffer, record.moves[ply]);
+            const unsigned int first = record.visitOffsets[ply];
+            const unsigned int last = record.visitOffsets[ply + 1];
+            if(moveCount > 0) {
+                const size_t shares = buffer.size();
+                buffer.resize(shares + moveCount, 0);
+                for(unsigned int i = first; i < last; ++i)
+                    buffer[shares + record.visits[i].move] = record.visits[i].share;
+                continue;
+            }
+            write_varint(buffer, last - first);
+            for(unsigned int i = first; i < last; ++i) {
+                write_varint(buffer, record.visits[i].move);
+                buffer.push_back(record.visits[i].share);
+            }
+        }
+        const uint32_t payloadSize = buffer.size() - 4;
+        for(unsigned int i = 0; i < 4; ++i)
+            buffer[i] = static_cast<uint8_t>(payloadSize >> (8 * i));
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        if(std::fwrite(buffer.data(), 1, buffer.size(), _file) != buffer.size())
+            return false;
+        //a crash loses at most the record being written
+        std::fflush(_file);
+        _writtenBytes += buffer.size();
+        return true;
+    }
+
+    size_t GameRecordWriter::get_written_bytes() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _writtenBytes;
+    }
+
+
+
+    GameRecordReader::GameRecordReader(const std::string& path) :
+        _data(nullptr),
+        _size(0),
+        _position(GAME_RECORD_MAGIC_SIZE),
+        _releasedUntil(0)
+    {
+        const int file = open(path.c_str(), O_RDONLY);
+        if(file < 0)
+            return;
+        struct stat fileStat;
+        if(fstat(file, &fileStat) == 0 and static_cast<size_t>(fileStat.st_size) >= GAME_RECORD_MAGIC_SIZE) {
+            void* data = mmap(nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+            if(data != MAP_FAILED) {
+                _data = static_cast<const uint8_t*>(data);
+                _size = fileStat.st_size;
+                madvise(data, _size, MADV_SEQUENTIAL);
+            }
+        }
+        //the mapping stays valid once the file is closed
+        close(file);
+
+        if(_data != nullptr and std::memcmp(_data, GAME_RECORD_MAGIC, GAME_RECORD_MAGIC_SIZE) != 0) {
+            munmap(const_cast<uint8_t*>(_data), _size);
+            _data = nullptr;
+            _size = 0;
+        }
+    }
+
+    GameRecordReader::~GameRecordReader() {
+        if(_data != nullptr)
+            munmap(const_cast<uint8_t*>(_data), _size);
+    }
+
+    bool GameRecordReader::is_open() const {
+        return _data != nullptr;
+    }
+
+    bool GameRecordReader::next(GameRecord& record) {
+        if(_data == nullptr or _size - _position < 4)
+            return false;
+
+        uint32_t payloadSize = 0;
+        for(unsigned int i = 0; i < 4; ++i)
+            payloadSize |= static_cast<uint32_t>(_data[_position + i]) << (8 * i);
+        if(_size - _position - 4 < payloadSize)
+            return false;   //cut record
+
+        const uint8_t* data = _data + _position + 4;
+        const uint8_t* end = data + payloadSize;
+        record.clear();
+
+        unsigned int plyCount;
+        if(not read_varint(data, end, plyCount) or data >= end)
+            return false;
+        record.score = *(data++) / 255.0f;
+        if(not read_varint(data, end, record.moveCount))
+            return false;
+        //a ply takes at least 2 bytes, a malformed count can not reserve more than the record
+        plyCount = std::min<unsigned int>(plyCount, payloadSize / 2 + 1);
+        record.moves.reserve(plyCount);
+        record.visitOffsets.reserve(plyCount + 1);
+        for(unsigned int ply = 0; ply < plyCount; ++ply) {
+            unsigned int move, visitedCount;
+            if(not read_varint(data, end, move))
+                return false;
+            record.moves.push_back(move);
+            if(record.moveCount > 0) {
+                if(static_cast<size_t>(end - data) < record.moveCount)
+                    return false;
+                for(unsigned int i = 0; i < record.moveCount; ++i) {
+                    if(data[i] > 0)
+                        record.visits.push_back({i, data[i]});
+                }
+                data += record.moveCount;
+                record.visitOffsets.push_back(record.visits.size());
+                continue;
+            }
+            if(not read_varint(data, end, visitedCount))
+                return false;
+            for(unsigned int i = 0; i < visitedCount; ++i) {
+                MoveVisits visits;
+                if(not read_varint(data, end, visits.move) or data >= end)
+                    return false;
+                visits.share = *(data++);
+                record.visits.push_back(visits);
+            }
+            record.visitOffsets.push_back(record.visits.size());
+        }
+        _position += 4 + payloadSize;
+
+        //give the decoded pages back to the kernel, the mapping is only read forward
+        const long pageSize = sysconf(_SC_PAGESIZE);
+        if(_position - _releasedUntil >= GAME_RECORD_RELEASE_BYTES) {
+            const size_t releaseEnd = _position / pageSize * pageSize;
+            madvise(const_cast<uint8_t*>(_data) + _releasedUntil, releaseEnd - _releasedUntil, MADV_DONTNEED);
+            _releasedUntil = releaseEnd;
+        }
+        return true;
+    }
+
+    void GameRecordReader::rewind() {
+        _position = GAME_RECORD_MAGIC_SIZE;
+        _releasedUntil = 0;
+    }
+
+    size_t GameRecordReader::get_file_size() const {
+        return _size;
+    }
+
+} /* MCTS */
@@ -0,0 +1,145 @@
+#ifndef MCTS_GAME_RECORD_CLASS_HPP
+#define MCTS_GAME_RECORD_CLASS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * \file    game_record.hpp
+ * \author  Baptiste Hudyma
+ * \version 1.0
+ * \date    11 mars 2021
+ *
+ * \brief   Compact binary records of played games: moves, root visit distributions and results
+ * \details A record file starts with an 8 bytes magic, followed by the records appended one after the other.
+ *          Each record is its payload size (4 bytes, little endian) then its payload:
+ *          - the ply count (varint), the final score of the first player quantized on one byte (0 to 255),
+ *            and the move count of the game (varint, GameRecord::moveCount), 0 if the moves are not numbered in a small fixed range
+ *          - with a move count, for each ply the move id played (varint) then the share of the root visits of every move id,
+ *            in move id order, quantized on one byte (0 for the moves without visits)
+ *          - without, for each ply the move id played (varint), the number of visited root children (varint),
+ *            then for each of them its move id (varint) and its share of the root visits, quantized on one byte
+ *          A Connect 4 ply takes 8 bytes. A ply played without a search (a random opening move) has no visited child.
+ *          A record cut by a crash ends the file for the readers, until the next GameRecordWriter on the file removes it.
+ */
+
+namespace MCTS {
+
+    /**
+     * \brief   Share of the root visits of a move, out of 255
+     */
+    struct MoveVisits {
+        unsigned int move;      //game wide move id (IGame_State::get_move_id)
+        uint8_t share;
+    };
+
+    /**
+     * \brief   One played game
+     */
+    struct GameRecord {
+        float score = 0.5f;                     //final score of the first player (IGame_State::get_score), quantized to 1/255 in the files
+        unsigned int moveCount = 0;             //move ids are below it: a share is stored for every move, without the ids. 0 to store the ids of the visited moves
+        std::vector<unsigned int> moves;        //move ids, in play order
+        std::vector<unsigned int> visitOffsets = std::vector<unsigned int>(1, 0);  //the visits of the ply i are visits[visitOffsets[i], visitOffsets[i + 1][
+        std::vector<MoveVisits> visits;         //root visit distributions of every ply
+
+        /**
+         * \brief Append a ply, quantizing the root visit counts in shares
+         *
+         * \param[in] move         Move id played
+         * \param[in] visitCounts  Move id and visit count of the root children, the children without visits are not stored.
+         *                         Empty for a move played without a search
+         */
+        void add_ply(unsigned int move, const std::vector<std::pair<unsigned int, unsigned int>>& visitCounts);
+
+        /**
+         * \brief Forget the plies, keeping the storage and the move count
+         */
+        void clear();
+
+        size_t get_ply_count() const { return moves.size(); }
+    };
+
+    /**
+     * \brief   Append game records to a file, from any number of threads
+     * \details Each record is encoded apart then written by a single call, so the records of concurrent games never interleave.
+     */
+    class GameRecordWriter {
+        public:
+            /**
+             * \param[in] path Record file, created if it does not exist, appended to otherwise.
+             *                 A record cut at the end of an existing file is removed before appending.
+             */
+            explicit GameRecordWriter(const std::string& path);
+
+            ~GameRecordWriter();
+
+            /**
+             * \return False if the file could not be opened, is not a record file, or its cut record could not be removed
+             */
+            bool is_open() const;
+
+            /**
+             * \brief Encode and append a record. Thread safe
+             *
+             * \return False if the write failed
+             */
+            bool append(const GameRecord& record);
+
+            /**
+             * \return The bytes appended by this writer
+             */
+            size_t get_written_bytes() const;
+
+        private:
+            std::FILE* _file;
+            mutable std::mutex _mutex;
+            size_t _writtenBytes;
+    };
+
+    /**
+     * \brief   Iterate the records of a file through a read only memory mapping
+     * \details The pages are read by the kernel as they are decoded, and those already decoded are released,
+     *          so files larger than the memory can be read.
+     */
+    class GameRecordReader {
+        public:
+            explicit GameRecordReader(const std::string& path);
+
+            ~GameRecordReader();
+
+            /**
+             * \return False if the file could not be mapped or is not a record file
+             */
+            bool is_open() const;
+
+            /**
+             * \brief Decode the next record in record, reusing its storage
+             * \details Without the move ids in the file (GameRecord::moveCount), the moves whose share was quantized to 0 are not decoded
+             *
+             * \return False at the end of the file, or on a cut or malformed record
+             */
+            bool next(GameRecord& record);
+
+            /**
+             * \brief Restart from the first record
+             */
+            void rewind();
+
+            size_t get_file_size() const;
+
+        private:
+            const uint8_t* _data;
+            size_t _size;
+            size_t _position;
+            size_t _releasedUntil;      //the pages before this offset were released with madvise
+    };
+
+} /* MCTS */
+
+#endif
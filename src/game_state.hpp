@@ -1,6 +1,7 @@
 #ifndef MCTS_GAME_STATE_CLASS_HPP
 #define MCTS_GAME_STATE_CLASS_HPP
 
+#include <cstddef>
 #include <list>
 #include <sstream>
 
@@ -56,6 +57,50 @@ class IGame_State {
          */
         virtual IGame_State* do_move(unsigned int index) = 0;
 
+        /**
+         * \brief       Return an identifier of the action at index, shared by every game state where this action is possible.
+         * \details     Used to compare moves played in different positions (RAVE). Do not need to be overloaded if the move indexes are already stable.
+         *
+         * \param[in]   index The index of the action, in [0, get_move_count()[
+         * \return      The identifier of this action
+         */
+        virtual unsigned int get_move_id(unsigned int index) const { return index; };
+
+        /**
+         * \brief       Return a cheap estimate of the quality of the action at index, for the player making it
+         * \details     Used to order the expansion of the children, and by the PUCT score as the softmax of the priors of the moves:
+         *              a prior higher by 1 makes a move e times more likely. Do not need to be overloaded, all moves are equal by default
+         *
+         * \param[in]   index The index of the action, in [0, get_move_count()[
+         * \return      A prior of this action, higher is better
+         */
+        virtual float get_move_prior(unsigned int index) const { return 1.0f; };
+
+        /**
+         * \brief       Return the bytes used by this game state, its own heap allocations included
+         * \details     Used by the tree memory reports. Do not need to be overloaded, 0 if unknown
+         */
+        virtual size_t get_memory_size() const { return 0; };
+
+        /**
+         * \brief       Return the player making the next action, for two player games
+         * \details     The scores are given for the player 0, in [0, 1]: the player 1 chooses its actions on 1 - score.
+         *              Do not need to be overloaded, by default every action is chosen to maximise the score
+         *
+         * \return      0 if the next action maximises the score, 1 if it minimises it
+         */
+        virtual unsigned int get_player_to_move() const { return 0; };
+
+        /**
+         * \brief       Return the canonical index of the action at index: the lowest index of the actions leading to game states equal to its own by a symmetry of the game
+         * \details     Used by SearchConfig::useSymmetries, to only search one action of each set of symmetric actions.
+         *              Do not need to be overloaded, the game has no symmetry by default
+         *
+         * \param[in]   index The index of the action, in [0, get_move_count()[
+         * \return      The canonical index of this action, lower or equal to index
+         */
+        virtual unsigned int get_canonical_move(unsigned int index) const { return index; };
+
         /**
          * \brief Overload of operator << used to display this game state
          * do not need to be overloaded
@@ -0,0 +1,47 @@
+#ifndef MCTS_LEAF_EVALUATOR_CLASS_HPP
+#define MCTS_LEAF_EVALUATOR_CLASS_HPP
+
+#include "game_state.hpp"
+
+#include <vector>
+
+/**
+ * \file    leaf_evaluator.hpp
+ * \author  Baptiste Hudyma
+ * \version 1.0
+ * \date    11 mars 2021
+ *
+ * \brief   Define the interface of the evaluators replacing the random rollouts
+ */
+
+namespace MCTS {
+
+/**
+ *
+ * \brief   Interface evaluating a batch of leaf game states at once
+ * \details Used by MCTS::search_best_move_batched instead of the random rollouts.
+ *          Evaluating many states per call amortizes the cost of the call itself (model inference, device transfer, ...).
+ */
+class ILeaf_Evaluator {
+    public:
+        virtual ~ILeaf_Evaluator() {};
+
+        /**
+         * \brief       Evaluate a batch of game states, none of them game over
+         *
+         * \param[in]   states The game states to evaluate
+         * \param[out]  values Resized to states.size(), the expected score of each state, in the scale of IGame_State::get_score
+         * \param[out]  priors If not null, resized to states.size(), the prior of each move of each state (by move index, higher is better)
+         */
+        virtual void evaluate(const std::vector<const IGame_State*>& states, std::vector<float>& values, std::vector<std::vector<float>>* priors) = 0;
+
+        /**
+         * \return      True if evaluate can fill the move priors
+         */
+        virtual bool has_priors() const { return false; };
+};
+
+
+} /* MCTS */
+
+#endif
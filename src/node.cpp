@@ -1,8 +1,13 @@
 #include "node.hpp"
+#include "random.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <new>
+#include <queue>
 
 namespace MCTS {
 
@@ -25,10 +30,15 @@ namespace MCTS {
      * \brief   Destructor
      */
     Node::~Node () {
-        //call children destructor
-        while( not _children.empty() ) {
-            delete _children.front();
-            _children.pop_front();
+        //free the subtree without recursion: each node is emptied of its children before being destroyed
+        std::vector<Node*> toDestroy(_children.begin(), _children.end());
+        _children.clear();
+        while(not toDestroy.empty()) {
+            Node* node = toDestroy.back();
+            toDestroy.pop_back();
+            toDestroy.insert(toDestroy.end(), node->_children.begin(), node->_children.end());
+            node->_children.clear();
+            Node::destroy(node);
         }
         //call state destructor
         delete _state;
@@ -42,8 +52,6 @@ namespace MCTS {
      */
     Node::Node(Node* parent, IGame_State* gameState) {
 
-        if(parent == nullptr)
-            std::cerr << "Node do not have a parent" << std::endl;
         if(gameState == nullptr)
             std::cerr << "Node cannot have empty game state" << std::endl;
 
@@ -51,19 +59,127 @@ namespace MCTS {
 
         _state = gameState;
         _moveIndex = 0;
+        _moveId = 0;
 
-        _isClosed = this->is_game_over(); 
+        _isGameOver = _state->is_game_over();
+        _isMinimizing = _state->get_player_to_move() == 1;
+        _isClosed = _isGameOver;
         _closedChildrenCount = 0;
 
         _visitCount = 0;
         _rewardValue = 0.0;
 
+        _amafVisitCount = 0;
+        _amafRewardValue = 0.0;
+
+        _virtualLoss = 0;
+
+        _prior = 1.0f;
+        _priorLogSum = -std::numeric_limits<float>::infinity();
+
+        _isInBuffer = false;
+        _hasPriorOrder = false;
+
         //reserve space for children and unexplored node tracking
         _unexploredChildren.reserve(_state->get_move_count());
         for(unsigned int i = 0; i < _state->get_move_count(); ++i)
             _unexploredChildren.push_back(i);
     }
 
+    Node::Node(Node&& other) :
+        _state(other._state),
+        _unexploredChildren(std::move(other._unexploredChildren)),
+        _parent(other._parent),
+        _children(std::move(other._children)),
+        _visitCount(other._visitCount),
+        _rewardValue(other._rewardValue),
+        _moveIndex(other._moveIndex),
+        _moveId(other._moveId),
+        _amafVisitCount(other._amafVisitCount),
+        _amafRewardValue(other._amafRewardValue),
+        _virtualLoss(other._virtualLoss),
+        _prior(other._prior),
+        _priorLogSum(other._priorLogSum),
+        _isInBuffer(false),
+        _hasPriorOrder(other._hasPriorOrder),
+        _isGameOver(other._isGameOver),
+        _isMinimizing(other._isMinimizing),
+        _isClosed(other._isClosed),
+        _closedChildrenCount(other._closedChildrenCount)
+    {
+        other._state = nullptr;
+        other._children.clear();
+    }
+
+    void Node::destroy(Node* node) {
+        if(node->_isInBuffer)
+            //the buffer memory is freed by its owner
+            node->~Node();
+        else
+            delete node;
+    }
+
+    size_t Node::count_nodes() const {
+        size_t count = 0;
+        std::vector<const Node*> toVisit(1, this);
+        while(not toVisit.empty()) {
+            const Node* node = toVisit.back();
+            toVisit.pop_back();
+            count += 1;
+            toVisit.insert(toVisit.end(), node->_children.begin(), node->_children.end());
+        }
+        return count;
+    }
+
+    Node* Node::relayout(Node* buffer, TreeLayout layout) {
+        //nodes in their buffer order
+        std::vector<Node*> order;
+        if(layout == TreeLayout::BreadthFirst) {
+            order.push_back(this);
+            for(size_t i = 0; i < order.size(); ++i)
+                order.insert(order.end(), order[i]->_children.begin(), order[i]->_children.end());
+        }
+        else {
+            //a child never has more visits than its parent, so parents come first
+            auto fewer_visits = [](const Node* a, const Node* b) { return a->_visitCount < b->_visitCount; };
+            std::priority_queue<Node*, std::vector<Node*>, decltype(fewer_visits)> toVisit(fewer_visits);
+            toVisit.push(this);
+            while(not toVisit.empty()) {
+                Node* node = toVisit.top();
+                toVisit.pop();
+                order.push_back(node);
+                for(Node* child : node->_children)
+                    toVisit.push(child);
+            }
+        }
+
+        //move the nodes, the old parent pointer becomes the forwarding address of the moved node
+        for(size_t i = 0; i < order.size(); ++i) {
+            Node* moved = new (&buffer[i]) Node(std::move(*order[i]));
+            moved->_isInBuffer = true;
+            order[i]->_parent = moved;
+        }
+
+        //follow the forwarding addresses, and rebuild the children lists in buffer order
+        for(size_t i = 0; i < order.size(); ++i) {
+            Node* moved = &buffer[i];
+            if(i > 0)
+                moved->_parent = moved->_parent->_parent;
+
+            std::list<Node*> children;
+            for(Node* child : moved->_children)
+                children.push_back(child->_parent);
+            moved->_children.swap(children);
+        }
+
+        //free the emptied nodes
+        for(Node* node : order) {
+            node->_parent = nullptr;
+            Node::destroy(node);
+        }
+        return buffer;
+    }
+
     /**
      * \fn bool is_fully_expanded ()
      * \brief  Check if all children of this node are already explored
@@ -74,6 +190,29 @@ namespace MCTS {
         return _unexploredChildren.size() <= 0; 
     }
 
+    /**
+     * \brief  Check if a new child can be expanded from this node
+     * \details With progressive widening, the children count is limited by the visit count of this node
+     *
+     * \return  Boolean: True if expand_children should be called on this node
+     */
+    bool Node::can_expand (const SearchConfig& config) const {
+        if(not this->can_widen(config))
+            return false;
+        //with first play urgency, the next move competes with the expanded children in get_best_child_UCT
+        return _children.empty() or not config.useFirstPlayUrgency;
+    }
+
+    bool Node::can_widen (const SearchConfig& config) const {
+        if(this->is_fully_expanded())
+            return false;
+        if(not config.useProgressiveWidening or _children.empty())
+            return true;
+
+        const float maxChildren = config.wideningCoefficient * pow(static_cast<float>(_visitCount), config.wideningExponent);
+        return _children.size() < maxChildren;
+    }
+
     /**
      * \brief Check if all this child's children were explored
      * 
@@ -90,7 +229,7 @@ namespace MCTS {
      * \return  The child Node object with the highest UCB1
      */
     Node* Node::get_best_child () const {
-        if(_state->is_game_over()) {
+        if(_isGameOver) {
             return nullptr;
         }
 
@@ -107,6 +246,18 @@ namespace MCTS {
         return bestChild;
     }
 
+    Node* Node::get_most_visited_child () const {
+        Node* bestChild = nullptr;
+        unsigned int mostVisits = 0;
+        for(Node* child : _children) {
+            if(bestChild == nullptr or child->get_visit_count() > mostVisits) {
+                bestChild = child;
+                mostVisits = child->get_visit_count();
+            }
+        }
+        return bestChild;
+    }
+
     /**
      * \fn Node* get_best_child ();
      * \brief  Return the child with the highest UCB1
@@ -114,7 +265,7 @@ namespace MCTS {
      * \return  The child Node object with the highest UCB1
      */
     Node* Node::get_best_child_UCB () const {
-        if(_state->is_game_over()) {
+        if(_isGameOver) {
             return nullptr;
         }
 
@@ -135,29 +286,44 @@ namespace MCTS {
     }
 
     /**
-     * \fn Node* get_best_child_UCT ();
+     * \fn Node* get_best_child_UCT (const SearchConfig& config);
      * \brief  Return the child with the highest UCT, discarding those which are fully explored
      *
      * \return  The child Node object with the highest UCT
      */
-    Node* Node::get_best_child_UCT () const {
-        if(_state->is_game_over()) {
+    Node* Node::get_best_child_UCT (const SearchConfig& config) const {
+        if(_isGameOver) {
             return nullptr;
         }
 
         Node* bestChild = nullptr;
         float bestUCBT = -10000;
+        float expandedPriors = 0.0f;
         for (Node* child : _children)
         {
+            expandedPriors += child->_prior;
             if(child->is_closed())
                 continue;   //do not select already explored child for exploration
 
-            float uct = child->get_UCT();
+            float uct = child->get_UCT(config);
             if (uct > bestUCBT) {
                 bestChild = child;
                 bestUCBT = uct;
             }
         }
+
+        if(config.useFirstPlayUrgency and bestChild != nullptr and this->can_widen(config)) {
+            //prior of the next expanded move: the highest one with the prior order, else the mean of the remaining ones
+            float nextPrior = 0.0f;
+            if(config.usePuct) {
+                if(config.useMovePriorOrder)
+                    nextPrior = exp(_state->get_move_prior(_unexploredChildren.back()) - _priorLogSum);
+                else
+                    nextPrior = std::max(0.0f, 1.0f - expandedPriors) / _unexploredChildren.size();
+            }
+            if(this->get_first_play_urgency(config, nextPrior) > bestUCBT)
+                return nullptr;     //expand the next move instead
+        }
         return bestChild;
     }
 
@@ -165,20 +331,26 @@ namespace MCTS {
     /**
      * \brief   Play a full game at random from this game state until a game_over
      *
+     * \param[out] playedMoves If not null, receives the move ids played during the rollout, in order
+     *
      * \return  The score of the final node
      */
-    float Node::rollout () {
+    float Node::rollout (std::vector<unsigned int>* playedMoves) {
         if(_state->is_game_over()) {
             return _state->get_score();
         }
 
-        unsigned int indexToExecute = rand() % _state->get_move_count();
+        unsigned int indexToExecute = random_index(_state->get_move_count());
+        if(playedMoves != nullptr)
+            playedMoves->push_back(_state->get_move_id(indexToExecute));
         std::unique_ptr<IGame_State> currentRolloutState(_state->do_move(indexToExecute));
 
         //while the game is not over
         while(not currentRolloutState->is_game_over()) {
             //get an available action from this game state
-            unsigned int indexToExecute = rand() % currentRolloutState->get_move_count();
+            unsigned int indexToExecute = random_index(currentRolloutState->get_move_count());
+            if(playedMoves != nullptr)
+                playedMoves->push_back(currentRolloutState->get_move_id(indexToExecute));
 
             //make a move, swap values and delete current state
             currentRolloutState = std::unique_ptr<IGame_State>(currentRolloutState->do_move(indexToExecute));
@@ -187,17 +359,15 @@ namespace MCTS {
         return currentRolloutState->get_score();
     }
 
-    void Node::rollout_expand () {
+    Node* Node::rollout_expand (const SearchConfig& config, unsigned int maxNodes) {
         Node* currentNode = this;
-
-        //while the game is not over
-        while(not currentNode->is_game_over()) {
-            //make a move
-            currentNode = currentNode->expand_children();
+        for(unsigned int i = 0; i < maxNodes and not currentNode->is_game_over(); ++i) {
+            Node* child = currentNode->expand_children(config);
+            if(child == nullptr)
+                break;
+            currentNode = child;
         }
-
-        float endScore = currentNode->_state->get_score();
-        currentNode->backpropagate(endScore);
+        return currentNode;
     }
 
 
@@ -236,6 +406,68 @@ namespace MCTS {
     }
 
 
+    /**
+     * \brief   Update the all-moves-as-first statistics of the children along the path from this node to the root
+     * \details Walks up from this node, keeping for each player the set of moves that player made later in the simulation.
+     *          The rollout moves alternate between the two players, starting with the player to move at this node.
+     *
+     * \param[in] reward       The reward of the simulation
+     * \param[in] rolloutMoves The move ids played during the rollout from this node
+     */
+    void Node::backpropagate_amaf (float reward, const std::vector<unsigned int>& rolloutMoves) {
+        //moves played after the current node, [0] by the player to move at this node, [1] by the other
+        std::vector<bool> playedMoves[2];
+        auto mark_played = [](std::vector<bool>& moves, unsigned int moveId) {
+            if(moveId >= moves.size())
+                moves.resize(moveId + 1, false);
+            moves[moveId] = true;
+        };
+
+        for(unsigned int ply = 0; ply < rolloutMoves.size(); ++ply)
+            mark_played(playedMoves[ply % 2], rolloutMoves[ply]);
+
+        unsigned int player = 0;
+        for(Node* node = this; node != nullptr; node = node->_parent) {
+            const std::vector<bool>& movesOfPlayer = playedMoves[player];
+            for(Node* child : node->_children) {
+                if(child->_moveId < movesOfPlayer.size() and movesOfPlayer[child->_moveId]) {
+                    child->_amafVisitCount += 1;
+                    child->_amafRewardValue += reward;
+                }
+            }
+
+            //the move leading to this node was played by the other player, before this node
+            player = 1 - player;
+            if(node->_parent != nullptr)
+                mark_played(playedMoves[player], node->_moveId);
+        }
+    }
+
+
+    /**
+     * \brief   Count a pending simulation as a lost visit, from this node to the root
+     */
+    void Node::add_virtual_loss () {
+        for(Node* node = this; node != nullptr; node = node->_parent)
+            node->_virtualLoss += 1;
+    }
+
+    /**
+     * \brief   Add a virtual loss to this node only
+     */
+    void Node::add_node_virtual_loss () {
+        _virtualLoss += 1;
+    }
+
+    /**
+     * \brief   Remove the virtual loss added by add_virtual_loss, from this node to the root
+     */
+    void Node::revert_virtual_loss () {
+        for(Node* node = this; node != nullptr; node = node->_parent)
+            node->_virtualLoss -= 1;
+    }
+
+
     /**
      * \brief   Get the UCB1 score
      * \details  Here, UCB1 is define as the reward value over the number of visits 
@@ -245,6 +477,8 @@ namespace MCTS {
     float Node::get_UCB1() const {
         if(_visitCount == 0)
             return 100000;  //infinity
+        if(_parent != nullptr and _parent->_isMinimizing)
+            return (_visitCount - _rewardValue) / static_cast<float>(_visitCount);
         return _rewardValue / static_cast<float>(_visitCount);
     }
 
@@ -254,36 +488,106 @@ namespace MCTS {
      *
      * \return  The UTC score
      */
-    float Node::get_UCT() const {
-        if(_parent == nullptr or _visitCount <= 0) {
+    float Node::get_UCT(const SearchConfig& config) const {
+        //simulations in flight count as lost visits
+        const unsigned int visitCount = _visitCount + _virtualLoss;
+        if(_parent == nullptr) {
             //parent is null, should be first node
             return this->get_UCB1();
         }
+        if(visitCount <= 0)
+            return config.useFirstPlayUrgency ? _parent->get_first_play_urgency(config, _prior) : this->get_UCB1();
+
+        //the virtual losses count as lost for the player who moved to this node
+        const bool isMinimizing = _parent->_isMinimizing;
+        float exploitation = (isMinimizing ? _visitCount - _rewardValue : _rewardValue) / static_cast<float>(visitCount);
+        if(config.useRave and _amafVisitCount > 0) {
+            //AMAF value dominates while this node has few visits
+            const float beta = sqrt(config.raveEquivalence / (3.0f * visitCount + config.raveEquivalence));
+            const float amafValue = (isMinimizing ? _amafVisitCount - _amafRewardValue : _amafRewardValue) / static_cast<float>(_amafVisitCount);
+            exploitation = (1.0f - beta) * exploitation + beta * amafValue;
+        }
+
+        if(config.usePuct)
+            return exploitation + config.explorationConstant * _prior * sqrt(static_cast<float>(_parent->_visitCount + _parent->_virtualLoss)) / (1.0f + visitCount);
+
         //else if(_parent->_parent == nullptr) {
         //parent's parent is null, first be first layer of the tree
-        return this->get_UCB1() + EXPLORATION_SCORE * sqrt( log(_parent->_visitCount) ) / sqrt(_visitCount);
+        return exploitation + config.explorationConstant * sqrt( log(_parent->_visitCount + _parent->_virtualLoss) ) / sqrt(visitCount);
         /*}
           else {
         //balance exploration and score
         return 
         this->get_UCB1() + 
-        EXPLORATION_SCORE * sqrt( log(_parent->_visitCount) ) / sqrt(_visitCount) +
+        config.explorationConstant * sqrt( log(_parent->_visitCount) ) / sqrt(_visitCount) +
         sqrt(_parent->_parent->_visitCount) / sqrt(_visitCount);
         }*/
     }
 
+    float Node::get_first_play_urgency(const SearchConfig& config, float prior) const {
+        if(config.usePuct)
+            return config.firstPlayUrgency + config.explorationConstant * prior * sqrt(static_cast<float>(_visitCount + _virtualLoss));
+        return config.firstPlayUrgency;
+    }
+
+    void Node::set_move_priors(const std::vector<float>& priors) {
+        if(not _children.empty())
+            return;
+        std::stable_sort(_unexploredChildren.begin(), _unexploredChildren.end(),
+                [&priors](unsigned int a, unsigned int b) { return priors[a] < priors[b]; });
+        _hasPriorOrder = true;
+    }
+
     /**
      * \brief   Create a new children from the game state posibilities
      *
      * \return  A new child object
      */
-    Node* Node::expand_children() {
+    Node* Node::expand_children(const SearchConfig& config) {
         if( this->is_fully_expanded() )
             //no more children to add
             return nullptr;
 
-        //choose index in [0, _state->get_move_count()[
-        unsigned int randomInt = rand() % _unexploredChildren.size();
+        if(config.useSymmetries and _children.empty()) {
+            //first expansion: drop the moves symmetric to a lower one, keeping the prior order if any
+            const IGame_State* state = _state;
+            _unexploredChildren.erase(std::remove_if(_unexploredChildren.begin(), _unexploredChildren.end(),
+                        [state](unsigned int index) { return state->get_canonical_move(index) != index; }),
+                    _unexploredChildren.end());
+        }
+
+        const bool shouldSortPriors = config.useMovePriorOrder and not _hasPriorOrder;
+        const bool shouldNormalizePriors = config.usePuct and std::isinf(_priorLogSum);
+        if(shouldSortPriors or shouldNormalizePriors) {
+            std::vector<float> priors(_state->get_move_count());
+            for(unsigned int i = 0; i < priors.size(); ++i)
+                priors[i] = _state->get_move_prior(i);
+            if(shouldSortPriors)
+                //first expansion: sort by increasing prior once, the best move is then always at the back
+                this->set_move_priors(priors);
+            if(shouldNormalizePriors) {
+                //softmax of the priors of the searched moves, expanded or not
+                std::vector<unsigned int> searchedMoves(_unexploredChildren);
+                for(const Node* child : _children)
+                    searchedMoves.push_back(child->_moveIndex);
+                float maxPrior = -std::numeric_limits<float>::infinity();
+                for(unsigned int index : searchedMoves)
+                    maxPrior = std::max(maxPrior, priors[index]);
+                float sum = 0.0f;
+                for(unsigned int index : searchedMoves)
+                    sum += exp(priors[index] - maxPrior);
+                _priorLogSum = maxPrior + log(sum);
+            }
+        }
+
+        unsigned int randomInt = 0;
+        if(config.useMovePriorOrder) {
+            randomInt = _unexploredChildren.size() - 1;
+        }
+        else {
+            //choose index in [0, _state->get_move_count()[
+            randomInt = random_index(_unexploredChildren.size());
+        }
 
         //create next game state
         unsigned int indexToChoose = _unexploredChildren[randomInt];
@@ -298,6 +602,8 @@ namespace MCTS {
         //create child node
         Node* child = new Node(this, newGS);
         child->_moveIndex = indexToChoose;
+        child->_moveId = _state->get_move_id(indexToChoose);
+        child->_prior = config.usePuct ? exp(_state->get_move_prior(indexToChoose) - _priorLogSum) : 1.0f / _state->get_move_count();
 
         _children.push_back(child);
 
@@ -390,8 +696,41 @@ namespace MCTS {
         return _moveIndex;
     }
 
+    Node* Node::get_parent() const {
+        return _parent;
+    }
+
+    const std::list<Node*>& Node::get_children() const {
+        return _children;
+    }
+
+    Node* Node::detach_child(unsigned int moveIndex) {
+        for(auto it = _children.begin(); it != _children.end(); ++it) {
+            Node* child = *it;
+            if(child->_moveIndex == moveIndex) {
+                _children.erase(it);
+                child->_parent = nullptr;
+                return child;
+            }
+        }
+
+        //move never explored, start a new tree
+        Node* child = new Node(_state->do_move(moveIndex));
+        child->_moveIndex = moveIndex;
+        child->_moveId = _state->get_move_id(moveIndex);
+        return child;
+    }
+
     bool Node::is_game_over() const {
-        return _state->is_game_over();
+        return _isGameOver;
+    }
+
+    const IGame_State* Node::get_game_state() const {
+        return _state;
+    }
+
+    size_t Node::get_unexplored_capacity() const {
+        return _unexploredChildren.capacity();
     }
 
     unsigned int Node::get_visit_count() const {
@@ -2,8 +2,10 @@
 #define MCTS_NODE_CLASS_HPP
 
 #include "game_state.hpp"
+#include "search_config.hpp"
 
 #include <list>
+#include <memory>
 #include <sstream>
 #include <vector>
 #include <map>
@@ -20,8 +22,6 @@
 
 namespace MCTS {
 
-#define EXPLORATION_SCORE 1.5
-
     /*
      *
      *
@@ -44,9 +44,11 @@ namespace MCTS {
             /**
              * \brief  Return the child with the highest UCT, discarding those which are fully explored
              *
+             * \param[in] config The search options (RAVE blending)
+             *
              * \return  The child Node object with the highest UCT
              */
-            Node* get_best_child_UCT () const; 
+            Node* get_best_child_UCT (const SearchConfig& config) const; 
 
             /**
              * \brief  Check if all children of this node are already explored
@@ -55,6 +57,16 @@ namespace MCTS {
              */
             bool is_fully_expanded () const;
 
+            /**
+             * \brief  Check if a new child can be expanded from this node
+             * \details With progressive widening, the children count is limited by the visit count of this node
+             *
+             * \param[in] config The search options
+             *
+             * \return  Boolean: True if expand_children should be called on this node
+             */
+            bool can_expand (const SearchConfig& config) const;
+
             /**
              * \brief  Return the child with the highest UCB1
              *
@@ -62,13 +74,32 @@ namespace MCTS {
              */
             Node* get_best_child () const;
 
+            /**
+             * \brief  Return the child with the most visits, the first one on a tie
+             *
+             * \return  The most visited child Node, nullptr if there is none
+             */
+            Node* get_most_visited_child () const;
+
             /**
              * \brief   Play a full game at random from this game state until a game_over
              *
+             * \param[out] playedMoves If not null, receives the move ids played during the rollout, in order
+             *
              * \return  The score of the final node
              */
-            float rollout ();
-            void rollout_expand ();
+            float rollout (std::vector<unsigned int>* playedMoves = nullptr);
+
+            /**
+             * \brief   Start a rollout by expanding random moves from this node, one level each, keeping them in the tree (expanding rollout)
+             * \details The rollout goes on from the returned node, and its result is backpropagated from there, visiting every new node
+             *
+             * \param[in] config   The search options (expansion order)
+             * \param[in] maxNodes Maximum number of nodes to expand
+             *
+             * \return  The last expanded node, this node if none could be expanded
+             */
+            Node* rollout_expand (const SearchConfig& config, unsigned int maxNodes);
 
             /**
              * \brief   Propagate the results from this node to parents until the root is reached
@@ -78,13 +109,40 @@ namespace MCTS {
              */
             void backpropagate (float reward);
 
+            /**
+             * \brief   Update the all-moves-as-first statistics of the children along the path from this node to the root
+             * \details A child is updated when its move was played later in the simulation by the same player, either in the tree or in the rollout
+             *
+             * \param[in] reward       The reward of the simulation
+             * \param[in] rolloutMoves The move ids played during the rollout from this node
+             */
+            void backpropagate_amaf (float reward, const std::vector<unsigned int>& rolloutMoves);
+
+            /**
+             * \brief   Count a pending simulation as a lost visit, from this node to the root
+             * \details Lowers the UCT of the path, so parallel selections spread over other paths until revert_virtual_loss is called
+             */
+            void add_virtual_loss ();
+
+            /**
+             * \brief   Add a virtual loss to this node only, for the descents adding it level by level. Removed by revert_virtual_loss from the leaf
+             */
+            void add_node_virtual_loss ();
+
+            /**
+             * \brief   Remove the virtual loss added by add_virtual_loss, from this node to the root
+             */
+            void revert_virtual_loss ();
+
 
             /**
              * \brief   Create a new children from the game state posibilities
              *
+             * \param[in] config The search options (expansion order)
+             *
              * \return  A new child object
              */
-            Node* expand_children();
+            Node* expand_children(const SearchConfig& config = SearchConfig());
 
             /**
              * \brief  Return the index of this node game state
@@ -93,6 +151,56 @@ namespace MCTS {
              */
             unsigned int get_move_index() const;
 
+            /**
+             * \return The parent of this node, null for the root
+             */
+            Node* get_parent() const;
+
+            /**
+             * \return The expanded children of this node
+             */
+            const std::list<Node*>& get_children() const;
+
+            /**
+             * \brief   Detach the child reached by a move, making it the root of its own tree
+             * \details The caller owns the returned node. If the move was not expanded yet, a new node is created.
+             *
+             * \param[in] moveIndex The index of the move in this node game state
+             *
+             * \return  The detached child, without parent
+             */
+            Node* detach_child(unsigned int moveIndex);
+
+            /**
+             * \brief   Free a node and its subtree, whether it was allocated alone or in a compaction buffer
+             */
+            static void destroy(Node* node);
+
+            /**
+             * \brief   Count the nodes of this subtree, this node included, without recursion
+             */
+            size_t count_nodes() const;
+
+            /**
+             * \brief   Order the expansion of the children by the given move priors instead of IGame_State::get_move_prior
+             * \details Only used with SearchConfig::useMovePriorOrder, and ignored once a child was expanded
+             *
+             * \param[in] priors Prior of each move index of this node game state, higher is expanded first
+             */
+            void set_move_priors(const std::vector<float>& priors);
+
+            /**
+             * \brief   Move the tree of this root node in a contiguous buffer, parents before children
+             * \details The nodes are move constructed in the buffer in the layout order, their children lists are rebuilt in the same order,
+             *          and the previous nodes are freed. The game states are not moved.
+             *
+             * \param[in] buffer Uninitialized memory for at least count_nodes() nodes, to free after every node in it was destroyed
+             * \param[in] layout Order of the nodes in the buffer
+             *
+             * \return  The new address of this node, the first of the buffer
+             */
+            Node* relayout(Node* buffer, TreeLayout layout);
+
 
             /**
              * \fn ~Node ();
@@ -104,6 +212,12 @@ namespace MCTS {
             //return this state move count
             unsigned int get_move_count() const ;
 
+            //return the game state of this node
+            const IGame_State* get_game_state() const;
+
+            //return the capacity of the unexplored children storage
+            size_t get_unexplored_capacity() const;
+
             //return this state game over state
             bool is_game_over() const ;
 
@@ -160,9 +274,14 @@ namespace MCTS {
              */
             Node(Node* parent, IGame_State* gameState);
 
+            /**
+             * \brief   Move constructor used by relayout: steals the game state, children and statistics of other
+             */
+            Node(Node&& other);
+
             /**
              * \brief   Get the UCB1 score
-             * \details  Here, UCB1 is define as the reward value over the number of visits 
+             * \details  Here, UCB1 is define as the reward value over the number of visits, for the player who moved to this node
              *
              * \return This node UCB1
              */
@@ -170,11 +289,29 @@ namespace MCTS {
 
             /**
              * \brief   Get the UCT score
-             * \details This score balances score and exploration to parse the tree
+             * \details This score balances score and exploration to parse the tree. With RAVE, the score is blended with the AMAF value.
+             *          The score is the one of the player who moved to this node.
+             *
+             * \param[in] config The search options
              *
              * \return  The UTC score
              */
-            float get_UCT() const;
+            float get_UCT(const SearchConfig& config) const;
+
+            /**
+             * \brief   Get the score of an unvisited move of this node (SearchConfig::useFirstPlayUrgency)
+             *
+             * \param[in] config The search options
+             * \param[in] prior  PUCT prior of the move
+             *
+             * \return  The first play urgency, with the PUCT exploration term
+             */
+            float get_first_play_urgency(const SearchConfig& config, float prior) const;
+
+            /**
+             * \brief  Check if the progressive widening lets this node expand a new child
+             */
+            bool can_widen(const SearchConfig& config) const;
 
 
             //friend ostream& operator<<(ostream& os, const Node& n);
@@ -187,7 +324,21 @@ namespace MCTS {
             unsigned int _visitCount;   //Child visits sum
             float _rewardValue;         //Child reward sum
             unsigned int _moveIndex;    //_state index
+            unsigned int _moveId;       //game wide identifier of the move leading to this node
+
+            unsigned int _amafVisitCount;   //simulations where this move was played later by the same player
+            float _amafRewardValue;         //reward sum of those simulations
+
+            unsigned int _virtualLoss;      //simulations in flight through this node
+
+            float _prior;                   //PUCT prior of the move leading to this node
+            float _priorLogSum;             //log of the sum of the exponential of the moves priors, -infinity until the first expansion with PUCT
+
+            bool _isInBuffer;               //True if this node lives in a compaction buffer, and must not be deleted
 
+            bool _hasPriorOrder;     //True once the unexplored children are sorted by prior
+            bool _isGameOver;        //Cached IGame_State::is_game_over, the state is not read during the selection
+            bool _isMinimizing;      //True if the player to move chooses its children on 1 - score (IGame_State::get_player_to_move)
             bool _isClosed;          //True while this node have unexplored children
             unsigned int _closedChildrenCount;       //count of the node's children which are closed
 
@@ -196,6 +347,18 @@ namespace MCTS {
 
     };
 
+    /**
+     * \brief   Free a compaction buffer, its nodes being already destroyed
+     */
+    struct NodeBufferDeleter {
+        void operator()(Node* buffer) const { ::operator delete(buffer); }
+    };
+
+    /**
+     * \brief   Uninitialized memory holding the nodes moved by Node::relayout
+     */
+    typedef std::unique_ptr<Node, NodeBufferDeleter> NodeBuffer;
+
 } /* MCTS */
 
 #endif
@@ -0,0 +1,208 @@
+#include "packed_tree.hpp"
+#include "random.hpp"
+
+#include <cmath>
+#include <limits>
+#include <memory>
+
+//parent index of the root
+#define NO_PARENT std::numeric_limits<uint32_t>::max()
+
+namespace MCTS {
+
+    static_assert(sizeof(PackedNode) == 16, "the selection reads four packed nodes per cache line");
+
+    namespace {
+
+        /**
+         * \brief Play a full game at random from state, as Node::rollout
+         */
+        float simulate(IGame_State* state) {
+            if(state->is_game_over())
+                return state->get_score();
+
+            std::unique_ptr<IGame_State> currentRolloutState(state->do_move(random_index(state->get_move_count())));
+            while(not currentRolloutState->is_game_over())
+                currentRolloutState = std::unique_ptr<IGame_State>(currentRolloutState->do_move(random_index(currentRolloutState->get_move_count())));
+            return currentRolloutState->get_score();
+        }
+
+    }
+
+    PackedTree::PackedTree(IGame_State* rootGameState, const SearchConfig& config, size_t maximumNodes) :
+        _rootState(rootGameState),
+        _config(config),
+        _maximumNodes((maximumNodes == 0 or maximumNodes > NO_PARENT) ? NO_PARENT : maximumNodes)
+    {
+        if(_config.randomSeed != 0)
+            seed_random(_config.randomSeed);
+        if(maximumNodes != 0) {
+            _nodes.reserve(_maximumNodes);
+            _parents.reserve(_maximumNodes);
+        }
+
+        _nodes.push_back({0, 0.0f, 0, 0});
+        _parents.push_back(NO_PARENT);
+        this->initialize(0, _rootState);
+        if(not _nodes[0].is_game_over())
+            this->expand(0, _rootState);
+    }
+
+    PackedTree::~PackedTree() {
+        delete _rootState;
+    }
+
+    unsigned int PackedTree::search_best_move(unsigned int iterations) {
+        this->run_iterations(iterations);
+        return this->get_best_move();
+    }
+
+    unsigned int PackedTree::run_iterations(unsigned int iterations) {
+        unsigned int done = 0;
+        while(done < iterations and not _nodes[0].is_closed()) {
+            this->run_iteration();
+            done += 1;
+        }
+        return done;
+    }
+
+    void PackedTree::run_iteration() {
+        _path.clear();
+        _path.push_back(0);
+
+        //the descent replays the moves from the root state
+        IGame_State* state = _rootState;
+        std::unique_ptr<IGame_State> descentState;
+        uint32_t index = 0;
+        while(not _nodes[index].is_game_over()) {
+            if(_nodes[index].firstChild == 0 and not this->expand(index, state))
+                break;  //no room left in the tree
+
+            index = this->select_child(index);
+            descentState.reset(state->do_move(_nodes[index].get_move_index()));
+            state = descentState.get();
+            _path.push_back(index);
+
+            if(_nodes[index].visitCount == 0) {
+                //first visit: the leaf is expanded on its next one
+                this->initialize(index, state);
+                break;
+            }
+        }
+
+        this->backpropagate(simulate(state));
+    }
+
+    bool PackedTree::expand(uint32_t index, const IGame_State* state) {
+        const unsigned int moveCount = state->get_move_count();
+        if(moveCount == 0 or moveCount > PackedNode::MAXIMUM_MOVES or moveCount > _maximumNodes - _nodes.size())
+            return false;
+
+        const uint32_t firstChild = _nodes.size();
+        for(unsigned int move = 0; move < moveCount; ++move) {
+            _nodes.push_back({0, 0.0f, 0, move});
+            _parents.push_back(index);
+        }
+        _nodes[index].firstChild = firstChild;
+        _nodes[index].bits |= moveCount << PackedNode::CHILD_COUNT_SHIFT;
+        return true;
+    }
+
+    uint32_t PackedTree::select_child(uint32_t index) const {
+        const PackedNode& node = _nodes[index];
+        const uint32_t firstChild = node.firstChild;
+        const unsigned int childCount = node.get_child_count();
+
+        //each visit past the first went to a child: some are unvisited while the visits do not exceed the children, take one at random
+        if(node.visitCount <= childCount) {
+            const unsigned int start = random_index(childCount);
+            for(unsigned int i = 0; i < childCount; ++i) {
+                const uint32_t child = firstChild + (start + i) % childCount;
+                if(_nodes[child].visitCount == 0)
+                    return child;
+            }
+        }
+
+        //same UCT as Node::get_UCT
+        const float exploration = _config.explorationConstant * sqrt(log(static_cast<float>(node.visitCount)));
+        const bool isMinimizing = node.is_minimizing();
+        uint32_t bestChild = firstChild;
+        float bestUCT = -10000;
+        for(uint32_t child = firstChild; child < firstChild + childCount; ++child) {
+            const PackedNode& childNode = _nodes[child];
+            if(childNode.is_closed())
+                continue;   //do not select already explored child for exploration
+
+            const float visitCount = static_cast<float>(childNode.visitCount);
+            const float exploitation = (isMinimizing ? visitCount - childNode.rewardValue : childNode.rewardValue) / visitCount;
+            const float uct = exploitation + exploration / sqrt(visitCount);
+            if(uct > bestUCT) {
+                bestChild = child;
+                bestUCT = uct;
+            }
+        }
+        return bestChild;
+    }
+
+    void PackedTree::initialize(uint32_t index, const IGame_State* state) {
+        if(state->is_game_over())
+            _nodes[index].bits |= PackedNode::GAME_OVER_FLAG | PackedNode::CLOSED_FLAG;
+        if(state->get_player_to_move() != 0)
+            _nodes[index].bits |= PackedNode::MINIMIZING_FLAG;
+    }
+
+    void PackedTree::backpropagate(float reward) {
+        //only the leaf can close a node: the selection never goes through a closed child
+        bool isChildClosed = false;
+        for(auto it = _path.rbegin(); it != _path.rend(); ++it) {
+            PackedNode& node = _nodes[*it];
+            node.visitCount += 1;
+            node.rewardValue += reward;
+
+            if(isChildClosed) {
+                const uint32_t lastChild = node.firstChild + node.get_child_count();
+                bool areChildrenClosed = true;
+                for(uint32_t child = node.firstChild; child < lastChild and areChildrenClosed; ++child)
+                    areChildrenClosed = _nodes[child].is_closed();
+                if(areChildrenClosed)
+                    node.bits |= PackedNode::CLOSED_FLAG;
+            }
+            isChildClosed = node.is_closed();
+        }
+    }
+
+    unsigned int PackedTree::get_best_move() const {
+        const PackedNode& root = _nodes[0];
+        const bool isMinimizing = root.is_minimizing();
+        unsigned int bestMove = 0;
+        float bestValue = -10000;
+        for(uint32_t child = root.firstChild; child < root.firstChild + root.get_child_count(); ++child) {
+            const PackedNode& childNode = _nodes[child];
+            if(childNode.visitCount == 0)
+                continue;
+            const float value = (isMinimizing ? childNode.visitCount - childNode.rewardValue : childNode.rewardValue) / static_cast<float>(childNode.visitCount);
+            if(value > bestValue) {
+                bestValue = value;
+                bestMove = childNode.get_move_index();
+            }
+        }
+        return bestMove;
+    }
+
+    size_t PackedTree::get_node_count() const {
+        return _nodes.size();
+    }
+
+    const PackedNode& PackedTree::get_node(uint32_t index) const {
+        return _nodes[index];
+    }
+
+    uint32_t PackedTree::get_parent(uint32_t index) const {
+        return _parents[index];
+    }
+
+    size_t PackedTree::get_memory_size() const {
+        return _nodes.capacity() * sizeof(PackedNode) + _parents.capacity() * sizeof(uint32_t) + _path.capacity() * sizeof(uint32_t) + _rootState->get_memory_size();
+    }
+
+} /* MCTS */
@@ -0,0 +1,141 @@
+#ifndef MCTS_PACKED_TREE_CLASS_HPP
+#define MCTS_PACKED_TREE_CLASS_HPP
+
+#include "game_state.hpp"
+#include "search_config.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * \file    packed_tree.hpp
+ * \author  Baptiste Hudyma
+ * \version 1.0
+ * \date    11 mars 2021
+ *
+ * \brief   Search tree of 16 byte nodes, linked by 32 bit indexes, for the large searches
+ */
+
+namespace MCTS {
+
+    /**
+     * \brief   Hot part of a node of a PackedTree: the fields read by the selection
+     * \details The children of a node are contiguous, from firstChild to firstChild + child count. The move index,
+     *          child count and flags share the last word.
+     */
+    struct PackedNode {
+        uint32_t visitCount;        //simulations through this node
+        float rewardValue;          //reward sum of those simulations, for the first player
+        uint32_t firstChild;        //index of the first child, 0 until the node is expanded (the root has index 0)
+        uint32_t bits;              //move index, child count and flags
+
+        static constexpr uint32_t MOVE_INDEX_BITS = 12;
+        static constexpr uint32_t CHILD_COUNT_BITS = 12;
+        static constexpr uint32_t MAXIMUM_MOVES = (1u << MOVE_INDEX_BITS) - 1;
+
+        static constexpr uint32_t CHILD_COUNT_SHIFT = MOVE_INDEX_BITS;
+        static constexpr uint32_t CLOSED_FLAG = 1u << (MOVE_INDEX_BITS + CHILD_COUNT_BITS);
+        static constexpr uint32_t GAME_OVER_FLAG = CLOSED_FLAG << 1;
+        static constexpr uint32_t MINIMIZING_FLAG = CLOSED_FLAG << 2;
+
+        unsigned int get_move_index() const { return bits & MAXIMUM_MOVES; }
+        unsigned int get_child_count() const { return (bits >> CHILD_COUNT_SHIFT) & MAXIMUM_MOVES; }
+        bool is_closed() const { return (bits & CLOSED_FLAG) != 0; }
+        bool is_game_over() const { return (bits & GAME_OVER_FLAG) != 0; }
+        bool is_minimizing() const { return (bits & MINIMIZING_FLAG) != 0; }
+    };
+
+    /**
+     * \brief   UCT search on a tree of PackedNode, a more compact but plainer alternative to the MCTS class
+     * \details A Node holds pointers, a children list, an unexplored moves vector and its game state, over 100 bytes with their heap blocks.
+     *          Here the nodes live in one vector of 16 byte PackedNode, read by the selection, and their parent indexes in a separate
+     *          vector: 20 bytes per node. No game state is kept in the tree, the descents replay the moves from the root state.
+     *          A node creates all its children at once, on its second visit, and unvisited children are selected first.
+     *          Only SearchConfig::explorationConstant and SearchConfig::randomSeed are used: no RAVE, PUCT, widening or virtual loss.
+     *          Games with more than PackedNode::MAXIMUM_MOVES moves per state are not supported.
+     */
+    class PackedTree {
+        public:
+            /**
+             * \param[in] rootGameState  The game state to search, owned by the tree
+             * \param[in] config         Search options
+             * \param[in] maximumNodes   Nodes the tree can hold, reserved at construction, 0 to grow without bound (up to 2^32 - 1 nodes)
+             */
+            PackedTree(IGame_State* rootGameState, const SearchConfig& config = SearchConfig(), size_t maximumNodes = 0);
+            ~PackedTree();
+
+            /**
+             * \brief Search for the action that maximises the tree score
+             *
+             * \param[in] iterations Number of iterations to run
+             *
+             * \return Index of the best action, corresponding to an index in rootGameState
+             */
+            unsigned int search_best_move(unsigned int iterations);
+
+            /**
+             * \return The number of iterations run, lower than iterations if the root closed
+             */
+            unsigned int run_iterations(unsigned int iterations);
+
+            /**
+             * \return Index of the root child with the best mean reward for the player to move, as MCTS::get_best_move
+             */
+            unsigned int get_best_move() const;
+
+            size_t get_node_count() const;
+            const PackedNode& get_node(uint32_t index) const;
+
+            /**
+             * \return Index of the parent of a node, 2^32 - 1 for the root (index 0)
+             */
+            uint32_t get_parent(uint32_t index) const;
+
+            /**
+             * \return Bytes reserved by the node vectors and the root game state
+             */
+            size_t get_memory_size() const;
+
+        protected:
+            /**
+             * \brief Select a leaf, simulate a game from it and backpropagate its score
+             */
+            void run_iteration();
+
+            /**
+             * \brief Create the children of a node, if the tree has room for them
+             *
+             * \return False if the node stays a leaf
+             */
+            bool expand(uint32_t index, const IGame_State* state);
+
+            /**
+             * \return Index of the child of an expanded node with the best UCT, not closed
+             */
+            uint32_t select_child(uint32_t index) const;
+
+            /**
+             * \brief Set the flags of a node from its game state, on its first visit
+             */
+            void initialize(uint32_t index, const IGame_State* state);
+
+            /**
+             * \brief Add a score to the nodes of _path, closing the nodes whose children all closed
+             */
+            void backpropagate(float reward);
+
+        private:
+            IGame_State* _rootState;
+            SearchConfig _config;
+            size_t _maximumNodes;
+
+            std::vector<PackedNode> _nodes;         //hot fields, read by the selection
+            std::vector<uint32_t> _parents;         //cold fields, by node index
+
+            std::vector<uint32_t> _path;            //nodes of the current iteration, from the root
+    };
+
+} /* MCTS */
+
+#endif
@@ -0,0 +1,191 @@
+#include "MCTS.hpp"
+#include "bounded_queue.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * \file    pipeline_search.cpp
+ * \author  Baptiste Hudyma
+ * \version 1.0
+ * \date    11 mars 2021
+ *
+ * \brief   Pipelined search: selection, rollout and backpropagation stages connected by lock free queues
+ */
+
+namespace MCTS {
+
+    namespace {
+
+        typedef std::chrono::steady_clock Clock;
+
+        struct PlayoutResult {
+            Node* leaf = nullptr;
+            float reward = 0.0f;
+            std::vector<unsigned int> moves;    //rollout moves, for RAVE
+        };
+
+        /**
+         * \brief Accumulate the working time of a stage thread
+         */
+        class BusyTimer {
+            public:
+                BusyTimer(std::atomic<long long>& total) : _total(total), _start(Clock::now()) {}
+                ~BusyTimer() {
+                    _total += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - _start).count();
+                }
+            private:
+                std::atomic<long long>& _total;
+                Clock::time_point _start;
+        };
+
+    }
+
+    unsigned int MCTS::search_best_move_pipeline(unsigned int iterations, PipelineStats* stats) {
+        this->stop();
+        _searchStartResidentBytes = start_resident_window();
+        //the nodes expanded here are not counted
+        _isNodeCountKnown = false;
+
+        const unsigned int selectionThreads = std::max(1u, _config.pipelineSelectionThreads);
+        unsigned int rolloutThreads = _config.pipelineRolloutThreads;
+        if(rolloutThreads == 0) {
+            const unsigned int hardwareThreads = std::thread::hardware_concurrency();
+            rolloutThreads = (hardwareThreads > selectionThreads + 1) ? hardwareThreads - selectionThreads - 1 : 1;
+        }
+
+        BoundedQueue<Node*> leafQueue(_config.pipelineQueueDepth);
+        BoundedQueue<PlayoutResult> resultQueue(_config.pipelineQueueDepth);
+
+        //selection and backpropagation take turns on the tree
+        std::mutex treeMutex;
+        std::atomic<unsigned int> issued(0);
+        std::atomic<unsigned int> runningSelections(selectionThreads);
+        std::atomic<unsigned int> runningRollouts(rolloutThreads);
+        std::atomic<long long> selectionBusy(0), rolloutBusy(0), backpropagationBusy(0);
+        unsigned int completed = 0;
+
+        auto selection_stage = [&]() {
+            while(true) {
+                if(issued.fetch_add(1) >= iterations) {
+                    issued -= 1;
+                    break;
+                }
+
+                Node* leaf = nullptr;
+                bool isRootClosed = false;
+                {
+                    std::lock_guard<std::mutex> lock(treeMutex);
+                    BusyTimer busy(selectionBusy);
+                    isRootClosed = _root->is_closed();
+                    if(not isRootClosed) {
+                        leaf = this->get_UCT_leaf();
+                        if(leaf != nullptr)
+                            leaf->add_virtual_loss();
+                    }
+                }
+                if(isRootClosed) {
+                    issued -= 1;
+                    break;
+                }
+                if(leaf == nullptr) {
+                    //every open path is waiting for a backpropagation
+                    issued -= 1;
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                while(not leafQueue.try_push(std::move(leaf)))
+                    std::this_thread::yield();
+            }
+            runningSelections -= 1;
+        };
+
+        auto rollout_stage = [&]() {
+            Node* leaf = nullptr;
+            while(true) {
+                if(not leafQueue.try_pop(leaf)) {
+                    //checked before the last pop, so no leaf pushed before the selections ended is missed
+                    if(runningSelections == 0 and not leafQueue.try_pop(leaf))
+                        break;
+                    if(leaf == nullptr) {
+                        std::this_thread::yield();
+                        continue;
+                    }
+                }
+
+                PlayoutResult result;
+                {
+                    BusyTimer busy(rolloutBusy);
+                    result.leaf = leaf;
+                    result.reward = leaf->rollout(_config.useRave ? &result.moves : nullptr);
+                }
+                leaf = nullptr;
+
+                while(not resultQueue.try_push(std::move(result)))
+                    std::this_thread::yield();
+            }
+            runningRollouts -= 1;
+        };
+
+        auto backpropagation_stage = [&]() {
+            PlayoutResult result;
+            while(true) {
+                if(not resultQueue.try_pop(result)) {
+                    if(runningRollouts == 0 and not resultQueue.try_pop(result))
+                        break;
+                    if(result.leaf == nullptr) {
+                        std::this_thread::yield();
+                        continue;
+                    }
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(treeMutex);
+                    BusyTimer busy(backpropagationBusy);
+                    result.leaf->revert_virtual_loss();
+                    result.leaf->backpropagate(result.reward);
+                    if(_config.useRave)
+                        result.leaf->backpropagate_amaf(result.reward, result.moves);
+                }
+                completed += 1;
+                result.leaf = nullptr;
+                result.moves.clear();
+            }
+        };
+
+        const Clock::time_point start = Clock::now();
+        std::vector<std::thread> threads;
+        for(unsigned int i = 0; i < selectionThreads; ++i)
+            threads.emplace_back(selection_stage);
+        for(unsigned int i = 0; i < rolloutThreads; ++i)
+            threads.emplace_back(rollout_stage);
+        threads.emplace_back(backpropagation_stage);
+        for(std::thread& thread : threads)
+            thread.join();
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        if(stats != nullptr) {
+            stats->iterations = completed;
+            stats->seconds = seconds;
+            stats->selectionThreads = selectionThreads;
+            stats->rolloutThreads = rolloutThreads;
+            stats->selectionUtilization = selectionBusy * 1e-9 / (seconds * selectionThreads);
+            stats->rolloutUtilization = rolloutBusy * 1e-9 / (seconds * rolloutThreads);
+            stats->backpropagationUtilization = backpropagationBusy * 1e-9 / seconds;
+        }
+
+        Node* bestChild = _root->get_best_child();
+        if(bestChild == nullptr) {
+            std::cerr << "Best child of root is null" << std::endl;
+            return 0;
+        }
+        _bestMoveSnapshot = bestChild->get_move_index();
+        return bestChild->get_move_index();
+    }
+
+} /* MCTS */
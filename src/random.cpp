@@ -0,0 +1,43 @@
+#include "random.hpp"
+
+#include <atomic>
+
+namespace MCTS {
+
+    namespace {
+
+        //splitmix64, turns any seed in a valid xorshift state
+        uint64_t mix_seed(uint64_t seed) {
+            seed += 0x9E3779B97F4A7C15ull;
+            seed = (seed ^ (seed >> 30)) * 0xBF58476D1CE4E5B9ull;
+            seed = (seed ^ (seed >> 27)) * 0x94D049BB133111EBull;
+            seed ^= seed >> 31;
+            return (seed == 0) ? 1 : seed;
+        }
+
+        //threads that never called seed_random get consecutive seeds
+        std::atomic<uint64_t> defaultSeed(1);
+
+        uint64_t& generator_state() {
+            thread_local uint64_t state = mix_seed(defaultSeed++);
+            return state;
+        }
+
+    }
+
+    void seed_random(uint64_t seed) {
+        generator_state() = mix_seed(seed);
+    }
+
+    unsigned int random_index(unsigned int count) {
+        //xorshift64*
+        uint64_t& state = generator_state();
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        const uint64_t value = state * 0x2545F4914F6CDD1Dull;
+        //multiply-shift reduction of the high bits in [0, count[
+        return static_cast<unsigned int>(((value >> 32) * count) >> 32);
+    }
+
+} /* MCTS */
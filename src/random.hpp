@@ -0,0 +1,36 @@
+#ifndef MCTS_RANDOM_HPP
+#define MCTS_RANDOM_HPP
+
+#include <cstdint>
+
+/**
+ * \file    random.hpp
+ * \author  Baptiste Hudyma
+ * \version 1.0
+ * \date    11 mars 2021
+ *
+ * \brief   Random generator used by the rollouts and expansions
+ * \details Each thread owns its generator, so searches running on several threads do not contend on the rand() lock.
+ */
+
+namespace MCTS {
+
+    /**
+     * \brief   Seed the random generator of the calling thread
+     *
+     * \param[in] seed Any value, two threads with the same seed draw the same numbers
+     */
+    void seed_random(uint64_t seed);
+
+    /**
+     * \brief   Draw a random index from the generator of the calling thread
+     *
+     * \param[in] count Number of possible values, must be > 0
+     *
+     * \return  An integer in [0, count[
+     */
+    unsigned int random_index(unsigned int count);
+
+} /* MCTS */
+
+#endif
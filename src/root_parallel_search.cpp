@@ -0,0 +1,278 @@
+#include "root_parallel_search.hpp"
+#include "MCTS.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+//words of a worker slot header: publication sequence, iterations, syncs, unused
+#define SLOT_HEADER_WORDS 4
+//worker slots start on their own cache line, after the segment header (stop flag, worker count, move count)
+#define SLOT_ALIGNMENT_WORDS 16
+
+//reads of a slot being written before it is skipped, its worker may have died while writing
+#define MAXIMUM_READ_ATTEMPTS 1000
+
+namespace MCTS {
+
+    namespace {
+
+        static_assert(std::atomic<uint32_t>::is_always_lock_free, "the shared memory segment needs address free atomics");
+
+        //segments created by this process, for unique names
+        std::atomic<unsigned int> segmentCounter(0);
+
+        size_t get_slot_words(unsigned int moveCount) {
+            const size_t words = SLOT_HEADER_WORDS + 2 * static_cast<size_t>(moveCount);
+            return (words + SLOT_ALIGNMENT_WORDS - 1) / SLOT_ALIGNMENT_WORDS * SLOT_ALIGNMENT_WORDS;
+        }
+
+        std::atomic<uint32_t>* get_slot(std::atomic<uint32_t>* segment, unsigned int moveCount, unsigned int workerIndex) {
+            return segment + SLOT_ALIGNMENT_WORDS + get_slot_words(moveCount) * workerIndex;
+        }
+
+        const std::atomic<uint32_t>* get_slot(const std::atomic<uint32_t>* segment, unsigned int moveCount, unsigned int workerIndex) {
+            return segment + SLOT_ALIGNMENT_WORDS + get_slot_words(moveCount) * workerIndex;
+        }
+
+        uint32_t to_bits(float value) {
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+
+        float from_bits(uint32_t bits) {
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+        /**
+         * \brief Map a zeroed segment shared with the forked workers: a POSIX shared memory object, or anonymous shared memory if it can not be created
+         */
+        void* map_segment(size_t size) {
+            const std::string name = "/mcts_root_" + std::to_string(getpid()) + "_" + std::to_string(segmentCounter++);
+            const int file = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+            if(file >= 0) {
+                //the mapping outlives the name: nothing is left behind if a process dies
+                shm_unlink(name.c_str());
+                void* segment = MAP_FAILED;
+                if(ftruncate(file, size) == 0)
+                    segment = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+                close(file);
+                if(segment != MAP_FAILED)
+                    return segment;
+            }
+            void* segment = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+            return (segment == MAP_FAILED) ? nullptr : segment;
+        }
+
+    }
+
+    RootParallelSearch::RootParallelSearch(unsigned int workerCount, const SearchConfig& config) :
+        _workerCount((workerCount == 0) ? std::max(1u, std::thread::hardware_concurrency()) : workerCount),
+        _config(config),
+        _moveCount(0),
+        _lastStats({0, 0, 0, false, 0.0})
+    {}
+
+    unsigned int RootParallelSearch::search_best_move(IGame_State* state, unsigned int iterations) {
+        typedef std::chrono::steady_clock Clock;
+        const Clock::time_point start = Clock::now();
+        _moveCount = state->get_move_count();
+        _lastStats = {0, 0, 0, false, 0.0};
+        _moveVisits.assign(_moveCount, 0);
+        _moveRewards.assign(_moveCount, 0.0f);
+
+        const size_t segmentSize = (SLOT_ALIGNMENT_WORDS + get_slot_words(_moveCount) * _workerCount) * sizeof(uint32_t);
+        std::atomic<uint32_t>* segment = static_cast<std::atomic<uint32_t>*>(map_segment(segmentSize));
+        if(segment == nullptr) {
+            std::cerr << "Could not map the root parallel search segment" << std::endl;
+            return 0;
+        }
+        segment[1].store(_workerCount, std::memory_order_relaxed);
+        segment[2].store(_moveCount, std::memory_order_relaxed);
+
+        //flush the buffered output once, instead of once per worker at their exit
+        std::cout.flush();
+        std::vector<pid_t> workers;
+        for(unsigned int i = 0; i < _workerCount; ++i) {
+            const pid_t pid = fork();
+            if(pid == 0)
+                this->run_worker(state, iterations, i, segment);
+            if(pid < 0)
+                break;
+            workers.push_back(pid);
+        }
+        _lastStats.workers = workers.size();
+        if(workers.empty()) {
+            std::cerr << "Could not start the root parallel search workers" << std::endl;
+            munmap(segment, segmentSize);
+            return 0;
+        }
+
+        //merge the published statistics until the workers are done, or stopped
+        const unsigned long long budget = static_cast<unsigned long long>(iterations) * workers.size();
+        const Clock::time_point deadline = (_config.moveTimeMilliseconds == 0) ? Clock::time_point::max() : start + std::chrono::milliseconds(_config.moveTimeMilliseconds);
+        std::vector<bool> isReaped(workers.size(), false);
+        size_t runningWorkers = workers.size();
+        bool isStopRequested = false;
+        while(runningWorkers > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            for(size_t i = 0; i < workers.size(); ++i) {
+                if(not isReaped[i] and waitpid(workers[i], nullptr, WNOHANG) == workers[i]) {
+                    isReaped[i] = true;
+                    runningWorkers -= 1;
+                }
+            }
+            if(runningWorkers == 0)
+                break;
+
+            const unsigned long long done = this->merge_workers(segment, workers.size());
+            if(done < budget and ((_config.useEarlyStop and this->is_settled(budget - done)) or Clock::now() >= deadline)) {
+                isStopRequested = true;
+                break;
+            }
+        }
+
+        segment[0].store(1, std::memory_order_release);
+        for(size_t i = 0; i < workers.size(); ++i) {
+            if(not isReaped[i])
+                waitpid(workers[i], nullptr, 0);
+        }
+        _lastStats.iterations = this->merge_workers(segment, workers.size());
+        //the workers may have spent their whole budget before seeing the stop flag
+        _lastStats.stoppedEarly = isStopRequested and _lastStats.iterations < budget;
+        munmap(segment, segmentSize);
+        _lastStats.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        return this->get_best_merged_move(state->get_player_to_move() != 0);
+    }
+
+    void RootParallelSearch::run_worker(IGame_State* state, unsigned int iterations, unsigned int workerIndex, std::atomic<uint32_t>* segment) {
+        //the fork only copied the calling thread: no background reclamation in the worker
+        SearchConfig config = _config;
+        config.reclaimInBackground = false;
+        config.randomSeed = ((_config.randomSeed == 0) ? 1 : _config.randomSeed) * 1000003ull + workerIndex;
+
+        //the tree takes the copy of state made by the fork, and is never destroyed
+        MCTS* tree = new MCTS(state, config);
+        std::atomic<uint32_t>* slot = get_slot(segment, _moveCount, workerIndex);
+        const unsigned int syncInterval = std::max(1u, _config.rootParallelSyncInterval);
+
+        unsigned int done = 0;
+        bool isStopped = false;
+        while(not isStopped) {
+            isStopped = done >= iterations or tree->get_root()->is_closed() or segment[0].load(std::memory_order_acquire) != 0;
+            if(not isStopped)
+                done += tree->run_iterations(std::min(syncInterval, iterations - done));
+
+            //seqlock publication: odd sequence while the statistics are written
+            const uint32_t sequence = slot[0].load(std::memory_order_relaxed);
+            slot[0].store(sequence + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            slot[1].store(done, std::memory_order_relaxed);
+            slot[2].store(slot[2].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            for(const Node* child : tree->get_root()->get_children()) {
+                slot[SLOT_HEADER_WORDS + child->get_move_index()].store(child->get_visit_count(), std::memory_order_relaxed);
+                slot[SLOT_HEADER_WORDS + _moveCount + child->get_move_index()].store(to_bits(child->get_score()), std::memory_order_relaxed);
+            }
+            slot[0].store(sequence + 2, std::memory_order_release);
+        }
+        _exit(0);
+    }
+
+    unsigned long long RootParallelSearch::merge_workers(const std::atomic<uint32_t>* segment, unsigned int workerCount) {
+        std::fill(_moveVisits.begin(), _moveVisits.end(), 0);
+        std::fill(_moveRewards.begin(), _moveRewards.end(), 0.0f);
+        std::vector<unsigned int> visits(_moveCount);
+        std::vector<float> rewards(_moveCount);
+
+        unsigned long long iterations = 0;
+        unsigned int syncs = 0;
+        for(unsigned int worker = 0; worker < workerCount; ++worker) {
+            const std::atomic<uint32_t>* slot = get_slot(segment, _moveCount, worker);
+            for(unsigned int attempt = 0; attempt < MAXIMUM_READ_ATTEMPTS; ++attempt) {
+                const uint32_t sequence = slot[0].load(std::memory_order_acquire);
+                if(sequence % 2 != 0)
+                    continue;
+                const unsigned int workerIterations = slot[1].load(std::memory_order_relaxed);
+                const unsigned int workerSyncs = slot[2].load(std::memory_order_relaxed);
+                for(unsigned int move = 0; move < _moveCount; ++move) {
+                    visits[move] = slot[SLOT_HEADER_WORDS + move].load(std::memory_order_relaxed);
+                    rewards[move] = from_bits(slot[SLOT_HEADER_WORDS + _moveCount + move].load(std::memory_order_relaxed));
+                }
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if(slot[0].load(std::memory_order_relaxed) != sequence)
+                    continue;
+
+                iterations += workerIterations;
+                syncs += workerSyncs;
+                for(unsigned int move = 0; move < _moveCount; ++move) {
+                    _moveVisits[move] += visits[move];
+                    _moveRewards[move] += rewards[move];
+                }
+                break;
+            }
+        }
+        _lastStats.syncs = syncs;
+        return iterations;
+    }
+
+    unsigned int RootParallelSearch::get_best_merged_move(bool isMinimizing) const {
+        //the early stop settles the most visited move: play it, as MCTS::search_best_move does (the workers publish no closed children)
+        if(_config.useEarlyStop)
+            return std::max_element(_moveVisits.begin(), _moveVisits.end()) - _moveVisits.begin();
+
+        //mean reward for the player to move, as Node::get_UCB1
+        unsigned int bestMove = 0;
+        float bestValue = -10000;
+        for(unsigned int move = 0; move < _moveCount; ++move) {
+            if(_moveVisits[move] == 0)
+                continue;
+            const float reward = isMinimizing ? _moveVisits[move] - _moveRewards[move] : _moveRewards[move];
+            const float value = reward / _moveVisits[move];
+            if(value > bestValue) {
+                bestValue = value;
+                bestMove = move;
+            }
+        }
+        return bestMove;
+    }
+
+    bool RootParallelSearch::is_settled(unsigned long long remainingIterations) const {
+        unsigned long long mostVisits = 0;
+        unsigned long long secondVisits = 0;
+        for(unsigned int visits : _moveVisits) {
+            if(visits > mostVisits) {
+                secondVisits = mostVisits;
+                mostVisits = visits;
+            }
+            else if(visits > secondVisits) {
+                secondVisits = visits;
+            }
+        }
+        return mostVisits > 0 and mostVisits - secondVisits > remainingIterations;
+    }
+
+    const std::vector<unsigned int>& RootParallelSearch::get_move_visits() const {
+        return _moveVisits;
+    }
+
+    const std::vector<float>& RootParallelSearch::get_move_rewards() const {
+        return _moveRewards;
+    }
+
+    const RootParallelStats& RootParallelSearch::get_last_stats() const {
+        return _lastStats;
+    }
+
+} /* MCTS */
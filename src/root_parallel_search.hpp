@@ -0,0 +1,106 @@
+#ifndef MCTS_ROOT_PARALLEL_SEARCH_CLASS_HPP
+#define MCTS_ROOT_PARALLEL_SEARCH_CLASS_HPP
+
+#include "game_state.hpp"
+#include "search_config.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+/**
+ * \file    root_parallel_search.hpp
+ * \author  Baptiste Hudyma
+ * \version 1.0
+ * \date    11 mars 2021
+ *
+ * \brief   Root parallel search in worker processes, merged through a POSIX shared memory segment
+ */
+
+namespace MCTS {
+
+    /**
+     * \brief   Activity of the last root parallel search
+     */
+    struct RootParallelStats {
+        unsigned int workers;                       //worker processes started
+        unsigned long long iterations;              //iterations of every worker
+        unsigned int syncs;                         //root statistics published by the workers
+        bool stoppedEarly;                          //the merged root statistics or the deadline stopped the workers before their budget was done
+        double seconds;
+    };
+
+    /**
+     * \brief   Search a position in several worker processes, each growing its own tree with a different seed, and merge their roots
+     * \details The workers are forked from the calling process, so they share nothing but a shared memory segment (shm_open) where each
+     *          worker publishes the visits and rewards of its root children every SearchConfig::rootParallelSyncInterval iterations.
+     *          The coordinator merges them while they search, and stops the workers once the merged statistics settle the move
+     *          (SearchConfig::useEarlyStop: the second most visited move can not catch the most visited one with the remaining
+     *          iterations of every worker) or once SearchConfig::moveTimeMilliseconds is spent.
+     *          The move is chosen on the summed visits and rewards, like MCTS::get_best_move on a single tree,
+     *          or is the most visited merged move with SearchConfig::useEarlyStop, the one the stop rule settles.
+     *          The workers never return from the search: they leave with _exit, without running the destructors or exit handlers of the process.
+     */
+    class RootParallelSearch {
+        public:
+            /**
+             * \param[in] workerCount  Worker processes, 0 for one per hardware thread
+             * \param[in] config       Search options of the workers
+             */
+            RootParallelSearch(unsigned int workerCount = 0, const SearchConfig& config = SearchConfig());
+
+            /**
+             * \brief Search a game state in the worker processes
+             *
+             * \param[in] state       The game state to search, still owned by the caller
+             * \param[in] iterations  Iterations of each worker
+             *
+             * \return Index of the best move of state
+             */
+            unsigned int search_best_move(IGame_State* state, unsigned int iterations);
+
+            /**
+             * \return The summed visits and rewards of the root moves of the last search, by move index
+             */
+            const std::vector<unsigned int>& get_move_visits() const;
+            const std::vector<float>& get_move_rewards() const;
+
+            const RootParallelStats& get_last_stats() const;
+
+        protected:
+            /**
+             * \brief Body of a worker process: search, publishing the root statistics in its slot of the segment, until done or stopped
+             */
+            void run_worker(IGame_State* state, unsigned int iterations, unsigned int workerIndex, std::atomic<uint32_t>* segment);
+
+            /**
+             * \brief Sum the last root statistics published by every worker
+             *
+             * \return The iterations of every worker
+             */
+            unsigned long long merge_workers(const std::atomic<uint32_t>* segment, unsigned int workerCount);
+
+            /**
+             * \return The best move of the merged statistics for the player to move, as the best child of a tree root,
+             *         or the most visited merged move with SearchConfig::useEarlyStop
+             */
+            unsigned int get_best_merged_move(bool isMinimizing) const;
+
+            /**
+             * \return True if more iterations of the workers can not change the most visited merged move
+             */
+            bool is_settled(unsigned long long remainingIterations) const;
+
+        private:
+            unsigned int _workerCount;
+            SearchConfig _config;
+            unsigned int _moveCount;                //root moves of the searched state
+
+            std::vector<unsigned int> _moveVisits;
+            std::vector<float> _moveRewards;
+            RootParallelStats _lastStats;
+    };
+
+} /* MCTS */
+
+#endif
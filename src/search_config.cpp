@@ -0,0 +1,179 @@
+#include "search_config.hpp"
+
+#include <functional>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace MCTS {
+
+    namespace {
+
+        /**
+         * \brief An option settable from the command line: flags take no value, and are written "1" or "0"
+         */
+        struct SearchOption {
+            const char* name;
+            const char* usage;
+            bool isFlag;
+            bool isInteger;                                                 //only takes unsigned integer values
+            std::function<void (SearchConfig&, const std::string&)> set;    //throws std::invalid_argument or std::out_of_range on a bad value
+            std::function<std::string (const SearchConfig&)> get;
+        };
+
+        std::string to_string(float value) {
+            std::ostringstream stream;
+            stream << value;
+            return stream.str();
+        }
+
+        float parse_float(const std::string& value) {
+            size_t parsed = 0;
+            const float result = std::stof(value, &parsed);
+            if(parsed != value.size())
+                throw std::invalid_argument(value);
+            return result;
+        }
+
+        unsigned long long parse_unsigned(const std::string& value) {
+            size_t parsed = 0;
+            const unsigned long long result = std::stoull(value, &parsed);
+            if(parsed != value.size() or value[0] == '-')
+                throw std::invalid_argument(value);
+            return result;
+        }
+
+        unsigned int parse_unsigned_int(const std::string& value) {
+            const unsigned long long result = parse_unsigned(value);
+            if(result > 0xFFFFFFFFull)
+                throw std::out_of_range(value);
+            return static_cast<unsigned int>(result);
+        }
+
+        SearchOption float_option(const char* name, const char* usage, float SearchConfig::* field) {
+            return {name, usage, false, false,
+                [field](SearchConfig& config, const std::string& value) { config.*field = parse_float(value); },
+                [field](const SearchConfig& config) { return to_string(config.*field); }};
+        }
+
+        SearchOption unsigned_option(const char* name, const char* usage, unsigned int SearchConfig::* field) {
+            return {name, usage, false, true,
+                [field](SearchConfig& config, const std::string& value) { config.*field = parse_unsigned_int(value); },
+                [field](const SearchConfig& config) { return std::to_string(config.*field); }};
+        }
+
+        SearchOption flag_option(const char* name, const char* usage, bool SearchConfig::* field) {
+            return {name, usage, true, false,
+                [field](SearchConfig& config, const std::string&) { config.*field = true; },
+                [field](const SearchConfig& config) { return std::string(config.*field ? "1" : "0"); }};
+        }
+
+        const std::vector<SearchOption>& get_options() {
+            static const std::vector<SearchOption> options = {
+                float_option("exploration", "UCT exploration constant", &SearchConfig::explorationConstant),
+                unsigned_option("iterations", "iterations per move, 0 for no limit", &SearchConfig::iterationsPerMove),
+                unsigned_option("time-ms", "wall clock time per move in milliseconds, 0 for no limit", &SearchConfig::moveTimeMilliseconds),
+                {"seed", "seed of the searching threads, 0 to keep their generators", false, true,
+                    [](SearchConfig& config, const std::string& value) { config.randomSeed = parse_unsigned(value); },
+                    [](const SearchConfig& config) { return std::to_string(config.randomSeed); }},
+                flag_option("rave", "blend the RAVE statistics of the rollouts", &SearchConfig::useRave),
+                float_option("rave-equivalence", "visits where the RAVE and UCT values weight the same", &SearchConfig::raveEquivalence),
+                flag_option("widening", "progressive widening", &SearchConfig::useProgressiveWidening),
+                float_option("widening-coefficient", "progressive widening coefficient k", &SearchConfig::wideningCoefficient),
+                float_option("widening-exponent", "progressive widening exponent alpha", &SearchConfig::wideningExponent),
+                flag_option("priors", "expand the moves by decreasing prior", &SearchConfig::useMovePriorOrder),
+                {"fpu", "first play urgency of the unexpanded moves, instead of expanding every move first", false, false,
+                    [](SearchConfig& config, const std::string& value) {
+                        config.firstPlayUrgency = parse_float(value);
+                        config.useFirstPlayUrgency = true;
+                    },
+                    [](const SearchConfig& config) { return config.useFirstPlayUrgency ? to_string(config.firstPlayUrgency) : std::string(); }},
+                {"puct", "PUCT exploration from the move priors, expanding by decreasing prior", true, false,
+                    [](SearchConfig& config, const std::string&) {
+                        config.usePuct = true;
+                        config.useMovePriorOrder = true;
+                    },
+                    [](const SearchConfig& config) { return std::string(config.usePuct ? "1" : "0"); }},
+                flag_option("symmetries", "only expand one move of each set of symmetric moves", &SearchConfig::useSymmetries),
+                unsigned_option("expand", "rollout moves kept in the tree by each iteration", &SearchConfig::rolloutExpansionNodes),
+                unsigned_option("node-budget", "tree nodes above which the rollouts are not kept, 0 for no bound", &SearchConfig::rolloutExpansionNodeBudget),
+                unsigned_option("batch", "leaves per evaluator call of the batched search", &SearchConfig::evaluationBatchSize),
+                flag_option("early-stop", "stop once the best move can not change", &SearchConfig::useEarlyStop),
+                unsigned_option("early-stop-window", "also stop once the best move is stable for this many iterations", &SearchConfig::earlyStopStableWindow),
+                unsigned_option("sync", "iterations between two root publications of a root parallel worker", &SearchConfig::rootParallelSyncInterval)
+            };
+            return options;
+        }
+
+        const SearchOption* find_option(const std::string& name) {
+            for(const SearchOption& option : get_options()) {
+                if(name == option.name)
+                    return &option;
+            }
+            return nullptr;
+        }
+
+    }
+
+    bool set_search_option(SearchConfig& config, const std::string& name, const std::string& value) {
+        const SearchOption* option = find_option(name);
+        if(option == nullptr or (not option->isFlag and value.empty()))
+            return false;
+
+        SearchConfig parsed = config;
+        try {
+            option->set(parsed, value);
+        }
+        catch(const std::logic_error&) {
+            //std::invalid_argument or std::out_of_range
+            return false;
+        }
+        config = parsed;
+        return true;
+    }
+
+    bool is_search_flag(const std::string& name) {
+        const SearchOption* option = find_option(name);
+        return option != nullptr and option->isFlag;
+    }
+
+    bool is_integer_search_option(const std::string& name) {
+        const SearchOption* option = find_option(name);
+        return option != nullptr and option->isInteger;
+    }
+
+    std::string get_search_option(const SearchConfig& config, const std::string& name) {
+        const SearchOption* option = find_option(name);
+        return (option == nullptr) ? std::string() : option->get(config);
+    }
+
+    std::string to_search_options(const SearchConfig& config) {
+        const SearchConfig defaultConfig;
+        std::string options;
+        for(const SearchOption& option : get_options()) {
+            const std::string value = option.get(config);
+            if(value == option.get(defaultConfig))
+                continue;
+
+            if(not options.empty())
+                options += " ";
+            options += std::string("--") + option.name;
+            if(not option.isFlag)
+                options += " " + value;
+        }
+        return options;
+    }
+
+    void show_search_options(std::ostream& stream, const std::string& prefix, const SearchConfig& defaults) {
+        for(const SearchOption& option : get_options()) {
+            const std::string name = "--" + prefix + option.name + (option.isFlag ? "" : " V");
+            stream << "  " << std::left << std::setw(28) << name << std::right << option.usage;
+            const std::string defaultValue = option.get(defaults);
+            if(not option.isFlag and not defaultValue.empty())
+                stream << " (" << defaultValue << ")";
+            stream << std::endl;
+        }
+    }
+
+} /* MCTS */
@@ -0,0 +1,227 @@
+#ifndef MCTS_SEARCH_CONFIG_CLASS_HPP
+#define MCTS_SEARCH_CONFIG_CLASS_HPP
+
+#include <ostream>
+#include <string>
+
+/**
+ * \file    search_config.hpp
+ * \author  Baptiste Hudyma
+ * \version 1.0
+ * \date    11 mars 2021
+ *
+ * \brief   Define the search options shared by the tree and its nodes
+ * \details Every optional search behaviour is disabled by default, so a default constructed configuration gives the plain UCT search.
+ *          The options can also be set at runtime from their command line names (set_search_option).
+ */
+
+namespace MCTS {
+
+    /**
+     * \brief   Order of the nodes in the buffer built by MCTS::compact
+     */
+    enum class TreeLayout {
+        BreadthFirst,   //level by level
+        VisitWeighted   //most visited nodes first, parents always before their children
+    };
+
+    /**
+     * \brief   Options of a Monte Carlo Tree Search
+     */
+    struct SearchConfig {
+        /**
+         * \brief   Weight of the exploration term of the UCT score
+         */
+        float explorationConstant = 1.5f;
+
+        /**
+         * \brief   Iterations of MCTS::search_best_move without argument, 0 for no iteration limit
+         */
+        unsigned int iterationsPerMove = 10000;
+
+        /**
+         * \brief   Wall clock time of MCTS::search_best_move without argument, in milliseconds, 0 for no time limit
+         * \details The search stops at the first limit reached, iterations or time
+         */
+        unsigned int moveTimeMilliseconds = 0;
+
+        /**
+         * \brief   Seed of the random generator of the threads running the search (random.hpp), 0 to keep the generators as they are
+         * \details Applied to the calling thread by the MCTS constructor and MCTS::set_config, and to the background search thread
+         */
+        unsigned long long randomSeed = 0;
+
+        /**
+         * \brief   Blend the all-moves-as-first (AMAF) statistics of the rollouts in the UCT score (RAVE)
+         */
+        bool useRave = false;
+
+        /**
+         * \brief   Visit count at which the RAVE and UCT values weight the same.
+         * \details The AMAF weight decays as sqrt(k / (3 * visits + k))
+         */
+        float raveEquivalence = 1000.0f;
+
+        /**
+         * \brief   Limit the number of children of a node to k * visits^alpha (progressive widening)
+         */
+        bool useProgressiveWidening = false;
+
+        /**
+         * \brief   Progressive widening coefficient k
+         */
+        float wideningCoefficient = 1.0f;
+
+        /**
+         * \brief   Progressive widening exponent alpha, in ]0, 1[
+         */
+        float wideningExponent = 0.5f;
+
+        /**
+         * \brief   Expand the unexplored children by decreasing IGame_State::get_move_prior instead of at random
+         */
+        bool useMovePriorOrder = false;
+
+        /**
+         * \brief   Give the unexpanded moves of a node a first play urgency, instead of expanding every move before revisiting a child
+         * \details The next move is only expanded when its urgency beats the UCT of every expanded child. The urgency is firstPlayUrgency,
+         *          plus the PUCT exploration term of an unvisited move with usePuct.
+         */
+        bool useFirstPlayUrgency = false;
+
+        /**
+         * \brief   Value of an unvisited move for the player making it, in the score range of the game
+         */
+        float firstPlayUrgency = 1.0f;
+
+        /**
+         * \brief   Use the PUCT exploration term c * P * sqrt(N) / (1 + n) instead of c * sqrt(ln(N) / n)
+         * \details The prior P of a move is the softmax of the IGame_State::get_move_prior of the node moves.
+         *          Combine with useMovePriorOrder, so that the next expanded move is the one with the highest prior.
+         */
+        bool usePuct = false;
+
+        /**
+         * \brief   Only expand the canonical moves of each node (IGame_State::get_canonical_move): the moves symmetric to another share its subtree
+         * \details The kept move is a legal move of the node, returned as is by the searches
+         */
+        bool useSymmetries = false;
+
+        /**
+         * \brief   Keep up to this many moves of each rollout as new nodes (expanding rollout), the rollout going on at random past them. 0 for plain rollouts
+         * \details Only used by search_best_move and the searches running run_iterations
+         */
+        unsigned int rolloutExpansionNodes = 0;
+
+        /**
+         * \brief   Stop expanding the rollouts once the tree holds this many nodes, 0 for no bound. The memory of a node is reported by MCTS::tree_stats
+         */
+        unsigned int rolloutExpansionNodeBudget = 0;
+
+        /**
+         * \brief   Threads running the selection and expansion stage of the pipelined search
+         */
+        unsigned int pipelineSelectionThreads = 1;
+
+        /**
+         * \brief   Threads running the rollout stage of the pipelined search, 0 for one per remaining hardware thread
+         */
+        unsigned int pipelineRolloutThreads = 0;
+
+        /**
+         * \brief   Capacity of each queue between the pipelined search stages, bounds the simulations in flight
+         */
+        unsigned int pipelineQueueDepth = 64;
+
+        /**
+         * \brief   Leaves collected (with virtual loss) before each call to the evaluator of the batched search
+         */
+        unsigned int evaluationBatchSize = 16;
+
+        /**
+         * \brief   Select the leaves of a batch with interleaved descents: each descent prefetches the next children and yields to the others while they load
+         */
+        bool interleaveDescents = false;
+
+        /**
+         * \brief   Stop search_best_move once the remaining budget can not let the second most visited root child catch the most visited one
+         * \details The search then plays the most visited root child instead of the one with the best mean reward, the move this bound settles
+         */
+        bool useEarlyStop = false;
+
+        /**
+         * \brief   Also stop once the most visited root child did not change for this many iterations, 0 to disable
+         * \details A heuristic: unlike the visit bound, more iterations could still change the move
+         */
+        unsigned int earlyStopStableWindow = 0;
+
+        /**
+         * \brief   Iterations between two checks of the early stop rules
+         * \details A timed search still checks its deadline at least every 64 iterations
+         */
+        unsigned int earlyStopCheckInterval = 128;
+
+        /**
+         * \brief   Iterations of a RootParallelSearch worker between two publications of its root statistics
+         */
+        unsigned int rootParallelSyncInterval = 1024;
+
+        /**
+         * \brief   Node order used when compacting on advance
+         */
+        TreeLayout treeLayout = TreeLayout::BreadthFirst;
+
+        /**
+         * \brief   Compact the tree each time MCTS::advance_root moves to a new root
+         * \details Also releases the compaction buffers, which otherwise keep the memory of the discarded siblings until the next MCTS::compact
+         */
+        bool compactOnAdvance = false;
+
+        /**
+         * \brief   Free the discarded trees (advance_root, destruction) on the shared TreeReclaimer thread instead of in the caller
+         * \details The reclaimer only runs on idle cores, so the memory of the discarded trees is returned later when every core searches
+         */
+        bool reclaimInBackground = false;
+    };
+
+    /**
+     * \brief   Set an option of a search configuration from its command line name (exploration, iterations, seed, rave...)
+     *
+     * \param[in] name   Name of the option, without the leading dashes
+     * \param[in] value  Value of the option, ignored by the flags (is_search_flag)
+     *
+     * \return  False if the option is unknown or its value is not valid, config is then unchanged
+     */
+    bool set_search_option(SearchConfig& config, const std::string& name, const std::string& value = "");
+
+    /**
+     * \return  True if the option is a flag, taking no value
+     */
+    bool is_search_flag(const std::string& name);
+
+    /**
+     * \return  True if the option only takes unsigned integer values (iterations, expand, batch...), and rejects "1.5"
+     */
+    bool is_integer_search_option(const std::string& name);
+
+    /**
+     * \return  The value of an option as set_search_option parses it, "1" or "0" for the flags, empty if the option is unknown
+     */
+    std::string get_search_option(const SearchConfig& config, const std::string& name);
+
+    /**
+     * \return  The options of config that differ from the default configuration, as a command line ("--exploration 0.8 --rave")
+     */
+    std::string to_search_options(const SearchConfig& config);
+
+    /**
+     * \brief   Write the usage of the search options, one option per line
+     *
+     * \param[in] prefix    Prefix of the option names, after the dashes
+     * \param[in] defaults  Configuration giving the default values shown
+     */
+    void show_search_options(std::ostream& stream, const std::string& prefix = "", const SearchConfig& defaults = SearchConfig());
+
+} /* MCTS */
+
+#endif
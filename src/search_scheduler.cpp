@@ -0,0 +1,124 @@
+#include "search_scheduler.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+namespace MCTS {
+
+    SearchScheduler::SearchScheduler(unsigned int threadCount, unsigned int sliceIterations, const SearchConfig& config) :
+        _config(config),
+        _sliceIterations(std::max(1u, sliceIterations)),
+        _startTime(Clock::now()),
+        _nextJobId(0),
+        _pendingJobs(0),
+        _totalIterations(0),
+        _pool(threadCount)
+    {
+    }
+
+    SearchScheduler::~SearchScheduler() {
+        this->wait_all();
+    }
+
+    unsigned int SearchScheduler::submit(IGame_State* state, unsigned int iterations, Callback callback) {
+        std::shared_ptr<Job> job = std::make_shared<Job>();
+        job->tree = std::make_unique<MCTS>(state, _config);
+        job->remainingIterations = std::max(1u, iterations);
+        job->iterations = 0;
+        job->slices = 0;
+        job->searchSeconds = 0.0;
+        job->submitTime = Clock::now();
+        job->callback = std::move(callback);
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            job->id = _nextJobId++;
+            _pendingJobs += 1;
+        }
+
+        const unsigned int jobId = job->id;
+        _pool.submit([this, job] { this->run_slice(job); });
+        return jobId;
+    }
+
+    void SearchScheduler::run_slice(std::shared_ptr<Job> job) {
+        const Clock::time_point sliceStart = Clock::now();
+        const unsigned int requested = std::min(_sliceIterations, job->remainingIterations);
+        const unsigned int done = job->tree->run_iterations(requested);
+        job->searchSeconds += std::chrono::duration<double>(Clock::now() - sliceStart).count();
+        job->iterations += done;
+        job->slices += 1;
+
+        //a short slice means the root closed
+        if(done < requested or done >= job->remainingIterations) {
+            this->complete(*job);
+            return;
+        }
+
+        job->remainingIterations -= done;
+        //back of the queue, behind the jobs waiting for a slice
+        _pool.submit([this, job] { this->run_slice(job); });
+    }
+
+    void SearchScheduler::complete(Job& job) {
+        SearchResult result;
+        result.jobId = job.id;
+        Node* bestChild = job.tree->get_best_move();
+        result.bestMove = (bestChild != nullptr) ? bestChild->get_move_index() : 0;
+        result.iterations = job.iterations;
+        result.slices = job.slices;
+        result.latencySeconds = std::chrono::duration<double>(Clock::now() - job.submitTime).count();
+        result.searchSeconds = job.searchSeconds;
+        result.state = job.tree->get_root()->_state;
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _totalIterations += job.iterations;
+            _latencies.push_back(result.latencySeconds);
+        }
+
+        if(job.callback)
+            job.callback(result);
+        job.tree.reset();
+
+        //after the callback, so jobs it submits are already pending
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _pendingJobs -= 1;
+        }
+        _jobsDone.notify_all();
+    }
+
+    void SearchScheduler::wait_all() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _jobsDone.wait(lock, [this] { return _pendingJobs == 0; });
+    }
+
+    SchedulerStats SearchScheduler::get_stats() const {
+        SchedulerStats stats;
+        std::vector<double> latencies;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            latencies = _latencies;
+            stats.totalIterations = _totalIterations;
+        }
+        stats.completedJobs = latencies.size();
+        stats.elapsedSeconds = std::chrono::duration<double>(Clock::now() - _startTime).count();
+        stats.iterationsPerSecond = stats.totalIterations / stats.elapsedSeconds;
+
+        stats.meanLatencySeconds = 0;
+        stats.p50LatencySeconds = 0;
+        stats.p99LatencySeconds = 0;
+        if(not latencies.empty()) {
+            std::sort(latencies.begin(), latencies.end());
+            stats.meanLatencySeconds = std::accumulate(latencies.begin(), latencies.end(), 0.0) / latencies.size();
+            stats.p50LatencySeconds = latencies[(latencies.size() - 1) / 2];
+            stats.p99LatencySeconds = latencies[(latencies.size() - 1) * 99 / 100];
+        }
+        return stats;
+    }
+
+    unsigned int SearchScheduler::get_thread_count() const {
+        return _pool.get_thread_count();
+    }
+
+} /* MCTS */
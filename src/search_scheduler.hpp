@@ -0,0 +1,132 @@
+#ifndef MCTS_SEARCH_SCHEDULER_CLASS_HPP
+#define MCTS_SEARCH_SCHEDULER_CLASS_HPP
+
+#include "game_state.hpp"
+#include "MCTS.hpp"
+#include "search_config.hpp"
+#include "thread_pool.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * \file    search_scheduler.hpp
+ * \author  Baptiste Hudyma
+ * \version 1.0
+ * \date    11 mars 2021
+ *
+ * \brief   Run the searches of many concurrent sessions on a shared thread pool
+ */
+
+namespace MCTS {
+
+    /**
+     * \brief   Result of a search job, given to the job callback
+     */
+    struct SearchResult {
+        unsigned int jobId;
+        unsigned int bestMove;          //index of the best move in the job game state
+        unsigned int iterations;        //iterations run, lower than the budget if the root closed
+        unsigned int slices;            //number of time slices used by the job
+        double latencySeconds;          //from submission to the end of the search
+        double searchSeconds;           //time spent running the job slices
+        IGame_State* state;             //the searched game state, only valid during the callback
+    };
+
+    /**
+     * \brief   Throughput and latency of the completed jobs
+     */
+    struct SchedulerStats {
+        unsigned int completedJobs;
+        unsigned long long totalIterations;
+        double elapsedSeconds;          //since the scheduler creation
+        double iterationsPerSecond;
+        double meanLatencySeconds;
+        double p50LatencySeconds;
+        double p99LatencySeconds;
+    };
+
+    /**
+     * \brief   Accept search jobs from many sessions and run them on a work stealing thread pool
+     * \details Each job owns its tree. Jobs are time sliced: a slice runs a fixed number of iterations,
+     *          then the job is queued again behind the other jobs, so a long search does not delay the short ones.
+     */
+    class SearchScheduler {
+        public:
+            typedef std::function<void(const SearchResult&)> Callback;
+
+            /**
+             * \param[in] threadCount       Number of worker threads, 0 for one per hardware thread
+             * \param[in] sliceIterations   Iterations run by a job before yielding its worker
+             * \param[in] config            Search options of every job
+             */
+            SearchScheduler(unsigned int threadCount = 0, unsigned int sliceIterations = 512, const SearchConfig& config = SearchConfig());
+
+            /**
+             * \brief Wait for the submitted jobs to complete
+             */
+            ~SearchScheduler();
+
+            /**
+             * \brief Queue a search. Can be called from any thread, including from a job callback.
+             *
+             * \param[in] state         The game state to search, owned by the scheduler
+             * \param[in] iterations    Iteration budget of the search
+             * \param[in] callback      Called on a worker thread with the result of the search
+             *
+             * \return The job id, also given in its result
+             */
+            unsigned int submit(IGame_State* state, unsigned int iterations, Callback callback);
+
+            /**
+             * \brief Block until every submitted job, including those submitted by callbacks, completed
+             */
+            void wait_all();
+
+            SchedulerStats get_stats() const;
+
+            unsigned int get_thread_count() const;
+
+        private:
+            typedef std::chrono::steady_clock Clock;
+
+            struct Job {
+                unsigned int id;
+                std::unique_ptr<MCTS> tree;
+                unsigned int remainingIterations;
+                unsigned int iterations;
+                unsigned int slices;
+                double searchSeconds;
+                Clock::time_point submitTime;
+                Callback callback;
+            };
+
+            /**
+             * \brief Run one slice of a job, then queue it again or complete it
+             */
+            void run_slice(std::shared_ptr<Job> job);
+
+            void complete(Job& job);
+
+            SearchConfig _config;
+            unsigned int _sliceIterations;
+            Clock::time_point _startTime;
+
+            mutable std::mutex _mutex;
+            std::condition_variable _jobsDone;
+            unsigned int _nextJobId;            //protected by _mutex
+            unsigned int _pendingJobs;          //protected by _mutex
+            unsigned long long _totalIterations;//protected by _mutex
+            std::vector<double> _latencies;     //protected by _mutex
+
+            //last member: destroyed first, so no task runs on the other members once they are destroyed
+            ThreadPool _pool;
+    };
+
+} /* MCTS */
+
+#endif
@@ -0,0 +1,104 @@
+#include "thread_pool.hpp"
+
+namespace MCTS {
+
+    thread_local const ThreadPool* ThreadPool::_currentPool = nullptr;
+    thread_local unsigned int ThreadPool::_currentWorker = 0;
+
+
+    ThreadPool::ThreadPool(unsigned int threadCount) :
+        _queuedTasks(0),
+        _isStopping(false),
+        _nextQueue(0)
+    {
+        if(threadCount == 0)
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+        for(unsigned int i = 0; i < threadCount; ++i)
+            _queues.push_back(std::make_unique<WorkerQueue>());
+        for(unsigned int i = 0; i < threadCount; ++i)
+            _threads.emplace_back(&ThreadPool::worker_loop, this, i);
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(_sleepMutex);
+            _isStopping = true;
+        }
+        _wakeUp.notify_all();
+        for(std::thread& thread : _threads)
+            thread.join();
+    }
+
+    void ThreadPool::submit(std::function<void()> task) {
+        unsigned int queueIndex = 0;
+        if(_currentPool == this)
+            queueIndex = _currentWorker;
+        else
+            queueIndex = _nextQueue++ % _queues.size();
+
+        {
+            std::lock_guard<std::mutex> lock(_queues[queueIndex]->mutex);
+            _queues[queueIndex]->tasks.push_back(std::move(task));
+        }
+        {
+            std::lock_guard<std::mutex> lock(_sleepMutex);
+            _queuedTasks += 1;
+        }
+        _wakeUp.notify_one();
+    }
+
+    unsigned int ThreadPool::get_thread_count() const {
+        return _threads.size();
+    }
+
+    bool ThreadPool::pop_task(unsigned int workerIndex, std::function<void()>& task) {
+        //own queue first, oldest task first
+        {
+            WorkerQueue& queue = *_queues[workerIndex];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if(not queue.tasks.empty()) {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+                return true;
+            }
+        }
+        //steal the oldest task of another queue, so the jobs queued first are not overtaken by later ones
+        for(unsigned int offset = 1; offset < _queues.size(); ++offset) {
+            WorkerQueue& queue = *_queues[(workerIndex + offset) % _queues.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if(not queue.tasks.empty()) {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void ThreadPool::worker_loop(unsigned int workerIndex) {
+        _currentPool = this;
+        _currentWorker = workerIndex;
+
+        std::function<void()> task;
+        while(true) {
+            {
+                std::unique_lock<std::mutex> lock(_sleepMutex);
+                _wakeUp.wait(lock, [this] { return _queuedTasks > 0 or _isStopping; });
+                if(_queuedTasks == 0)
+                    //stopping, and nothing left to run
+                    return;
+                //reserve a task, it is in one of the queues
+                _queuedTasks -= 1;
+            }
+
+            while(not this->pop_task(workerIndex, task)) {
+                //the reserved task is still being pushed
+                std::this_thread::yield();
+            }
+            task();
+            task = nullptr;
+        }
+    }
+
+} /* MCTS */
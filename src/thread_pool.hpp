@@ -0,0 +1,82 @@
+#ifndef MCTS_THREAD_POOL_CLASS_HPP
+#define MCTS_THREAD_POOL_CLASS_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * \file    thread_pool.hpp
+ * \author  Baptiste Hudyma
+ * \version 1.0
+ * \date    11 mars 2021
+ *
+ * \brief   Work stealing thread pool
+ */
+
+namespace MCTS {
+
+    /**
+     * \brief   Fixed size pool of threads, each with its own task queue
+     * \details A worker runs the tasks of its own queue in submission order, and steals the oldest task of the other queues when it is empty.
+     *          Tasks submitted from a worker go to its own queue, the others are spread over the queues.
+     */
+    class ThreadPool {
+        public:
+            /**
+             * \param[in] threadCount Number of worker threads, 0 for one per hardware thread
+             */
+            explicit ThreadPool(unsigned int threadCount = 0);
+
+            /**
+             * \brief Run the remaining tasks, then join the workers
+             */
+            ~ThreadPool();
+
+            /**
+             * \brief Queue a task, to be run by any worker
+             */
+            void submit(std::function<void()> task);
+
+            unsigned int get_thread_count() const;
+
+        private:
+            ThreadPool(const ThreadPool&) = delete;
+            ThreadPool& operator=(const ThreadPool&) = delete;
+
+            struct WorkerQueue {
+                std::mutex mutex;
+                std::deque<std::function<void()>> tasks;
+            };
+
+            void worker_loop(unsigned int workerIndex);
+
+            /**
+             * \brief Take a task from the worker queue, or steal one from another queue
+             *
+             * \return True if a task was found
+             */
+            bool pop_task(unsigned int workerIndex, std::function<void()>& task);
+
+            std::vector<std::unique_ptr<WorkerQueue>> _queues;
+            std::vector<std::thread> _threads;
+
+            std::mutex _sleepMutex;
+            std::condition_variable _wakeUp;
+            unsigned int _queuedTasks;          //protected by _sleepMutex
+            bool _isStopping;                   //protected by _sleepMutex
+            std::atomic<unsigned int> _nextQueue;
+
+            //pool and queue of the current thread, when it is a worker
+            static thread_local const ThreadPool* _currentPool;
+            static thread_local unsigned int _currentWorker;
+    };
+
+} /* MCTS */
+
+#endif
@@ -0,0 +1,130 @@
+#include "time_manager.hpp"
+
+#include <algorithm>
+
+//changes of the best move counted by the instability extension
+#define MAXIMUM_COUNTED_CHANGES 4
+
+namespace MCTS {
+
+    TimeManager::TimeManager(const TimeControl& control) :
+        _control(control)
+    {
+        this->start_game();
+    }
+
+    void TimeManager::start_game() {
+        _remainingMilliseconds = _control.gameMilliseconds;
+        _moveNumber = 0;
+        _baseBudget = 0.0;
+        _maximumBudget = 0.0;
+        _moveBudget = 0.0;
+        _lastBestChild = nullptr;
+        _bestMoveChanges = 0;
+        _hasFlagged = false;
+        _extendedMoves = 0;
+        _cutMoves = 0;
+    }
+
+    double TimeManager::start_move() {
+        const double available = std::max(0.0, _remainingMilliseconds - _control.safetyMilliseconds);
+        const unsigned int movesToGo = std::max(_control.minimumMovesToGo, (_control.expectedMoves > _moveNumber) ? _control.expectedMoves - _moveNumber : 0u);
+
+        //the increment is only credited once the move is played: never budget more than the clock holds now
+        //at least a millisecond of search, even on an empty clock
+        _baseBudget = std::max(1.0, std::min(available, available / std::max(1u, movesToGo) + _control.incrementMilliseconds));
+        //never more than half of the clock on a single move
+        _maximumBudget = std::max(_baseBudget, std::min({_baseBudget * _control.maximumExtension, available / 2.0 + _control.incrementMilliseconds, available}));
+        _moveBudget = _baseBudget;
+        _lastBestChild = nullptr;
+        _bestMoveChanges = 0;
+        return _baseBudget;
+    }
+
+    double TimeManager::get_move_budget(const Node* root) {
+        //nothing to search: closed root or a single move
+        if(root->is_closed() or (root->get_move_count() <= 1 and root->is_fully_expanded()))
+            return 0.0;
+        if(not _control.adaptive)
+            return _moveBudget;
+
+        unsigned int rootVisits = 0;
+        unsigned int mostVisits = 0;
+        unsigned int secondVisits = 0;
+        const Node* mostVisited = nullptr;
+        for(const Node* child : root->get_children()) {
+            const unsigned int visits = child->get_visit_count();
+            rootVisits += visits;
+            if(visits > mostVisits) {
+                secondVisits = mostVisits;
+                mostVisits = visits;
+                mostVisited = child;
+            }
+            else if(visits > secondVisits) {
+                secondVisits = visits;
+            }
+        }
+
+        const Node* bestChild = root->get_best_child();
+        if(bestChild != _lastBestChild and _lastBestChild != nullptr)
+            _bestMoveChanges += 1;
+        _lastBestChild = bestChild;
+        if(rootVisits == 0)
+            return _moveBudget;
+
+        double budget = _baseBudget;
+        const double share = static_cast<double>(mostVisits) / rootVisits;
+        const double gap = static_cast<double>(mostVisits - secondVisits) / rootVisits;
+        if(share >= _control.dominantShare and mostVisited == bestChild and root->is_fully_expanded()) {
+            //the best move is also the most visited one by far
+            budget *= _control.cutShare;
+        }
+        else {
+            double extension = 1.0;
+            if(gap < _control.closeGap)
+                extension += (_control.closeGap - gap) / _control.closeGap;
+            extension *= 1.0 + _control.instabilityExtension * std::min(_bestMoveChanges, static_cast<unsigned int>(MAXIMUM_COUNTED_CHANGES));
+            budget *= extension;
+        }
+        _moveBudget = std::min(budget, _maximumBudget);
+        return _moveBudget;
+    }
+
+    void TimeManager::end_move(double elapsedMilliseconds) {
+        if(_moveBudget > _baseBudget * 1.01)
+            _extendedMoves += 1;
+        else if(_moveBudget < _baseBudget * 0.99)
+            _cutMoves += 1;
+
+        //the clock is checked before the increment is credited
+        if(elapsedMilliseconds > _remainingMilliseconds)
+            _hasFlagged = true;
+        _remainingMilliseconds += _control.incrementMilliseconds - elapsedMilliseconds;
+        _moveNumber += 1;
+    }
+
+    double TimeManager::get_remaining_milliseconds() const {
+        return _remainingMilliseconds;
+    }
+
+    bool TimeManager::has_flagged() const {
+        return _hasFlagged;
+    }
+
+    unsigned int TimeManager::get_move_number() const {
+        return _moveNumber;
+    }
+
+    unsigned int TimeManager::get_extended_moves() const {
+        return _extendedMoves;
+    }
+
+    unsigned int TimeManager::get_cut_moves() const {
+        return _cutMoves;
+    }
+
+    const TimeControl& TimeManager::get_time_control() const {
+        return _control;
+    }
+
+} /* MCTS */
@@ -0,0 +1,113 @@
+#ifndef MCTS_TIME_MANAGER_CLASS_HPP
+#define MCTS_TIME_MANAGER_CLASS_HPP
+
+#include "node.hpp"
+
+/**
+ * \file    time_manager.hpp
+ * \author  Baptiste Hudyma
+ * \version 1.0
+ * \date    11 mars 2021
+ *
+ * \brief   Share the clock of a whole game between its moves
+ */
+
+namespace MCTS {
+
+    /**
+     * \brief   Clock of a player for a whole game, and the rules spending it
+     */
+    struct TimeControl {
+        unsigned int gameMilliseconds = 60000;      //clock of the player at the start of the game
+        unsigned int incrementMilliseconds = 0;     //added to the clock after each move
+        unsigned int safetyMilliseconds = 10;       //kept on the clock for the search overhead
+
+        unsigned int expectedMoves = 30;            //moves of the player in a game
+        unsigned int minimumMovesToGo = 5;          //moves the remaining clock is shared between, at least
+
+        bool adaptive = true;                       //adjust the budget of a move to the search, false for a flat budget
+        float maximumExtension = 3.0f;              //maximum budget of a move, in base budgets
+        float closeGap = 0.1f;                      //visit gap of the two most visited root children, in root visits, below which the move is extended
+        float instabilityExtension = 0.25f;         //extension per change of the best move, up to 4 changes
+        float dominantShare = 0.75f;                //visit share of the most visited root child above which the move is cut
+        float cutShare = 0.3f;                      //budget of a cut move, in base budgets
+    };
+
+    /**
+     * \brief   Decide the budget of each move from the remaining clock, the move number and the state of the search
+     * \details Each move gets a base budget, the remaining clock shared between the expected moves to go, plus the increment,
+     *          never more than the remaining clock since the increment is only credited after the move.
+     *          During the search, get_move_budget extends it when the two most visited root children are close or the best
+     *          move keeps changing, and cuts it when a single child dominates the root visits.
+     *          MCTS::search_best_move(TimeManager&) calls the three stages of a move.
+     */
+    class TimeManager {
+        public:
+            TimeManager(const TimeControl& control = TimeControl());
+
+            /**
+             * \brief Reset the clock and move number for a new game
+             */
+            void start_game();
+
+            /**
+             * \brief Start the clock of a move
+             *
+             * \return The base budget of the move, in milliseconds
+             */
+            double start_move();
+
+            /**
+             * \brief Budget of the current move, given the state of its search
+             *
+             * \param[in] root Root of the searched tree
+             *
+             * \return The total time the move may take, in milliseconds, 0 if the search should stop now
+             */
+            double get_move_budget(const Node* root);
+
+            /**
+             * \brief Stop the clock of a move: spend its time and add the increment
+             */
+            void end_move(double elapsedMilliseconds);
+
+            /**
+             * \return The time left on the clock, negative if the player overran it
+             */
+            double get_remaining_milliseconds() const;
+
+            /**
+             * \return True if a move of this game took longer than the clock held when it started, the increment of that move not counting
+             */
+            bool has_flagged() const;
+
+            unsigned int get_move_number() const;
+
+            /**
+             * \return Moves whose budget was extended beyond, or cut below, the base budget since start_game
+             */
+            unsigned int get_extended_moves() const;
+            unsigned int get_cut_moves() const;
+
+            const TimeControl& get_time_control() const;
+
+        private:
+            TimeControl _control;
+
+            double _remainingMilliseconds;
+            unsigned int _moveNumber;
+
+            double _baseBudget;                 //of the current move
+            double _maximumBudget;
+            double _moveBudget;                 //last budget given to the current move
+            const Node* _lastBestChild;         //best root child at the last check, to count the best move changes
+            unsigned int _bestMoveChanges;
+            bool _hasFlagged;                   //the clock ran out during a move since start_game
+
+            unsigned int _extendedMoves;
+            unsigned int _cutMoves;
+    };
+
+} /* MCTS */
+
+#endif
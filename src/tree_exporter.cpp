@@ -0,0 +1,167 @@
+#include "tree_exporter.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <iostream>
+
+namespace MCTS {
+
+    namespace {
+
+        struct PendingNode {
+            const Node* node;
+            size_t parentId;
+            unsigned int depth;
+        };
+
+    }
+
+    TreeExporter::TreeExporter(const ExportFilter& filter, size_t bufferBytes) :
+        _filter(filter),
+        _buffer(std::max<size_t>(bufferBytes, 64)),
+        _used(0),
+        _file(nullptr),
+        _hasFailed(false)
+    {
+    }
+
+    size_t TreeExporter::export_tree(const Node* root, ExportFormat format, const std::string& path) {
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        if(file == nullptr) {
+            std::cerr << "Can not open " << path << " to export the tree" << std::endl;
+            return 0;
+        }
+        const size_t nodeCount = this->export_tree(root, format, file);
+        if(std::fclose(file) != 0)
+            return 0;
+        return nodeCount;
+    }
+
+    size_t TreeExporter::export_tree(const Node* root, ExportFormat format, std::FILE* file) {
+        _file = file;
+        _used = 0;
+        _hasFailed = false;
+
+        const bool isJson = (format == ExportFormat::Json);
+        this->write(isJson ? "{\"nodes\":[\n" : "digraph MCTS {\nnode [shape=box];\n");
+
+        size_t nodeCount = 0;
+        std::vector<PendingNode> toWrite;
+        toWrite.push_back({root, 0, 0});
+        while(not toWrite.empty() and not _hasFailed) {
+            const PendingNode pending = toWrite.back();
+            toWrite.pop_back();
+
+            //ids follow the writing order, the parent always being written first
+            const size_t id = nodeCount;
+            const Node* node = pending.node;
+            const unsigned int visits = node->get_visit_count();
+            const double meanScore = (visits > 0) ? node->get_score() / visits : 0.0;
+            const bool isRoot = (id == 0);
+
+            if(isJson) {
+                this->write(isRoot ? "{\"id\":" : ",\n{\"id\":");
+                this->write_number(static_cast<unsigned long long>(id));
+                if(not isRoot) {
+                    this->write(",\"parent\":");
+                    this->write_number(static_cast<unsigned long long>(pending.parentId));
+                    this->write(",\"move\":");
+                    this->write_number(static_cast<unsigned long long>(node->get_move_index()));
+                }
+                this->write(",\"depth\":");
+                this->write_number(static_cast<unsigned long long>(pending.depth));
+                this->write(",\"visits\":");
+                this->write_number(static_cast<unsigned long long>(visits));
+                this->write(",\"score\":");
+                this->write_number(meanScore);
+                this->write(node->is_closed() ? ",\"closed\":true}" : ",\"closed\":false}");
+            }
+            else {
+                this->write("n");
+                this->write_number(static_cast<unsigned long long>(id));
+                if(isRoot)
+                    this->write(" [label=\"root");
+                else {
+                    this->write(" [label=\"move ");
+                    this->write_number(static_cast<unsigned long long>(node->get_move_index()));
+                }
+                this->write("\\nV ");
+                this->write_number(static_cast<unsigned long long>(visits));
+                this->write("\\nQ ");
+                this->write_number(meanScore);
+                this->write(node->is_closed() ? "\", style=dashed];\n" : "\"];\n");
+                if(not isRoot) {
+                    this->write("n");
+                    this->write_number(static_cast<unsigned long long>(pending.parentId));
+                    this->write(" -> n");
+                    this->write_number(static_cast<unsigned long long>(id));
+                    this->write(";\n");
+                }
+            }
+            nodeCount += 1;
+
+            if(pending.depth >= _filter.maxDepth)
+                continue;
+            this->select_children(node);
+            //pushed in reverse so that the first kept child is written first
+            for(auto it = _keptChildren.rbegin(); it != _keptChildren.rend(); ++it)
+                toWrite.push_back({*it, id, pending.depth + 1});
+        }
+
+        this->write(isJson ? "\n]}\n" : "}\n");
+        this->flush();
+        _file = nullptr;
+        return _hasFailed ? 0 : nodeCount;
+    }
+
+    void TreeExporter::select_children(const Node* node) {
+        _keptChildren.clear();
+        for(const Node* child : node->get_children()) {
+            if(child->get_visit_count() >= _filter.minVisits)
+                _keptChildren.push_back(child);
+        }
+
+        if(_filter.topChildren > 0 and _keptChildren.size() > _filter.topChildren) {
+            auto more_visits = [](const Node* a, const Node* b) { return a->get_visit_count() > b->get_visit_count(); };
+            std::partial_sort(_keptChildren.begin(), _keptChildren.begin() + _filter.topChildren, _keptChildren.end(), more_visits);
+            _keptChildren.resize(_filter.topChildren);
+        }
+    }
+
+    void TreeExporter::write(const char* text) {
+        this->write(text, std::strlen(text));
+    }
+
+    void TreeExporter::write(const char* text, size_t length) {
+        if(_used + length > _buffer.size()) {
+            this->flush();
+            if(length > _buffer.size()) {
+                //larger than the whole buffer: write it directly
+                _hasFailed |= (std::fwrite(text, 1, length, _file) != length);
+                return;
+            }
+        }
+        std::memcpy(_buffer.data() + _used, text, length);
+        _used += length;
+    }
+
+    void TreeExporter::write_number(unsigned long long value) {
+        char text[32];
+        const std::to_chars_result result = std::to_chars(text, text + sizeof(text), value);
+        this->write(text, result.ptr - text);
+    }
+
+    void TreeExporter::write_number(double value) {
+        char text[32];
+        const std::to_chars_result result = std::to_chars(text, text + sizeof(text), value, std::chars_format::general, 6);
+        this->write(text, result.ptr - text);
+    }
+
+    void TreeExporter::flush() {
+        if(_used > 0 and _file != nullptr)
+            _hasFailed |= (std::fwrite(_buffer.data(), 1, _used, _file) != _used);
+        _used = 0;
+    }
+
+} /* MCTS */
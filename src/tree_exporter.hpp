@@ -0,0 +1,92 @@
+#ifndef MCTS_TREE_EXPORTER_CLASS_HPP
+#define MCTS_TREE_EXPORTER_CLASS_HPP
+
+#include "node.hpp"
+
+#include <cstdio>
+#include <limits>
+#include <string>
+#include <vector>
+
+/**
+ * \file    tree_exporter.hpp
+ * \author  Baptiste Hudyma
+ * \version 1.0
+ * \date    11 mars 2021
+ *
+ * \brief   Stream a search tree to a JSON or Graphviz DOT file
+ */
+
+namespace MCTS {
+
+    /**
+     * \brief   File formats of the TreeExporter
+     */
+    enum class ExportFormat {
+        Json,   //{"nodes": [...]}, one object per node in depth first order: id, parent id, move index, depth, visits, mean score, closed flag
+        Dot     //Graphviz digraph
+    };
+
+    /**
+     * \brief   Nodes kept by the TreeExporter. The root is always kept, a child is kept if its parent is
+     */
+    struct ExportFilter {
+        unsigned int minVisits = 0;                                         //skip the children with fewer visits
+        unsigned int topChildren = 0;                                       //keep only the most visited children of each node, 0 to keep them all
+        unsigned int maxDepth = std::numeric_limits<unsigned int>::max();   //skip the nodes deeper than this, the root being at depth 0
+    };
+
+    /**
+     * \brief   Write a tree through a large buffer, without recursion
+     * \details Unlike Node::show_node, nothing is flushed per node: the buffer is only written to the file once full, so trees of millions of nodes export in seconds.
+     */
+    class TreeExporter {
+        public:
+            /**
+             * \param[in] filter       Nodes to export
+             * \param[in] bufferBytes  Size of the write buffer
+             */
+            explicit TreeExporter(const ExportFilter& filter = ExportFilter(), size_t bufferBytes = 1 << 20);
+
+            /**
+             * \brief Export a tree to a file
+             *
+             * \param[in] root    Root of the tree
+             * \param[in] format  File format
+             * \param[in] path    Path of the file, replaced if it exists
+             *
+             * \return The number of exported nodes, 0 if the file could not be written
+             */
+            size_t export_tree(const Node* root, ExportFormat format, const std::string& path);
+
+            /**
+             * \brief Export a tree to an open file
+             *
+             * \return The number of exported nodes, 0 if the file could not be written
+             */
+            size_t export_tree(const Node* root, ExportFormat format, std::FILE* file);
+
+        private:
+            void write(const char* text);
+            void write(const char* text, size_t length);
+            void write_number(unsigned long long value);
+            void write_number(double value);
+            void flush();
+
+            /**
+             * \brief Fill _keptChildren with the children of node passing the filter, most visited first if only the top ones are kept
+             */
+            void select_children(const Node* node);
+
+            ExportFilter _filter;
+            std::vector<char> _buffer;
+            size_t _used;
+            std::FILE* _file;
+            bool _hasFailed;
+
+            std::vector<const Node*> _keptChildren;
+    };
+
+} /* MCTS */
+
+#endif
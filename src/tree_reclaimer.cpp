@@ -0,0 +1,105 @@
+#include "tree_reclaimer.hpp"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+//trees queued before reclaim frees the next ones in the caller
+#define MAX_PENDING_TREES 4
+
+namespace MCTS {
+
+    TreeReclaimer::TreeReclaimer() :
+        _isFreeing(false),
+        _isStopping(false)
+    {
+        _thread = std::thread(&TreeReclaimer::reclaim_loop, this);
+#ifdef __linux__
+        //lowest normal priority: yield to the searches, but still get a share of a busy machine (SCHED_IDLE could starve)
+        sched_param parameters {};
+        pthread_setschedparam(_thread.native_handle(), SCHED_BATCH, &parameters);
+#endif
+    }
+
+    TreeReclaimer::~TreeReclaimer() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _isStopping = true;
+        }
+        _wakeUp.notify_all();
+        _thread.join();
+    }
+
+    TreeReclaimer& TreeReclaimer::get_shared() {
+        static TreeReclaimer sharedReclaimer;
+        return sharedReclaimer;
+    }
+
+    void TreeReclaimer::reclaim(Node* root, std::vector<NodeBuffer>&& buffers) {
+        bool isQueueFull = false;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            isQueueFull = root != nullptr and _trees.size() >= MAX_PENDING_TREES;
+            if(not isQueueFull)
+                _trees.push_back({root, std::move(buffers)});
+        }
+        if(not isQueueFull) {
+            _wakeUp.notify_one();
+            return;
+        }
+
+        //the reclaimer is behind: free the nodes here rather than letting the queue grow
+        Node::destroy(root);
+        if(buffers.empty())
+            return;
+        //only queue the buffers once the nodes of this tree are gone: the trees queued before may also have nodes in them
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _trees.push_back({nullptr, std::move(buffers)});
+        }
+        _wakeUp.notify_one();
+    }
+
+    void TreeReclaimer::wait_idle() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _idle.wait(lock, [this] { return _trees.empty() and not _isFreeing; });
+    }
+
+    size_t TreeReclaimer::get_pending_count() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _trees.size() + (_isFreeing ? 1 : 0);
+    }
+
+    void TreeReclaimer::reclaim_loop() {
+#ifdef __linux__
+        //the nice value is per thread on Linux
+        setpriority(PRIO_PROCESS, gettid(), 19);
+#endif
+        std::unique_lock<std::mutex> lock(_mutex);
+        while(true) {
+            _wakeUp.wait(lock, [this] { return _isStopping or not _trees.empty(); });
+            if(_trees.empty())
+                //stopping, and every tree was freed
+                break;
+
+            DiscardedTree tree = std::move(_trees.front());
+            _trees.pop_front();
+            _isFreeing = true;
+            lock.unlock();
+
+            //nodes first: some may live in the buffers
+            if(tree.root != nullptr)
+                Node::destroy(tree.root);
+            tree.buffers.clear();
+
+            lock.lock();
+            _isFreeing = false;
+            if(_trees.empty())
+                _idle.notify_all();
+        }
+    }
+
+} /* MCTS */
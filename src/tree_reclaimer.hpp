@@ -0,0 +1,83 @@
+#ifndef MCTS_TREE_RECLAIMER_CLASS_HPP
+#define MCTS_TREE_RECLAIMER_CLASS_HPP
+
+#include "node.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * \file    tree_reclaimer.hpp
+ * \author  Baptiste Hudyma
+ * \version 1.0
+ * \date    11 mars 2021
+ *
+ * \brief   Free discarded trees on a background thread
+ */
+
+namespace MCTS {
+
+    /**
+     * \brief   Thread freeing the trees handed to it, so that discarding a tree costs the caller a single queue push
+     * \details The trees are freed in submission order, without recursion, by a SCHED_BATCH thread at nice 19.
+     *          When a few trees are already pending, reclaim frees the nodes in the caller so the queue stays bounded on a busy machine.
+     *          A discarded tree must not be used after reclaim.
+     */
+    class TreeReclaimer {
+        public:
+            TreeReclaimer();
+
+            /**
+             * \brief Free the remaining trees, then join the thread
+             */
+            ~TreeReclaimer();
+
+            /**
+             * \brief Reclaimer shared by every tree of the process, started on first use
+             */
+            static TreeReclaimer& get_shared();
+
+            /**
+             * \brief Queue a tree to free, or free its nodes right away if the queue is full
+             *
+             * \param[in] root     Root of the discarded tree, or nullptr to only free buffers
+             * \param[in] buffers  Compaction buffers, freed after the nodes of this tree and of the trees queued before
+             */
+            void reclaim(Node* root, std::vector<NodeBuffer>&& buffers = std::vector<NodeBuffer>());
+
+            /**
+             * \brief Block until every queued tree was freed
+             */
+            void wait_idle();
+
+            /**
+             * \return Number of trees queued or being freed
+             */
+            size_t get_pending_count();
+
+        private:
+            TreeReclaimer(const TreeReclaimer&) = delete;
+            TreeReclaimer& operator=(const TreeReclaimer&) = delete;
+
+            struct DiscardedTree {
+                Node* root;
+                std::vector<NodeBuffer> buffers;
+            };
+
+            void reclaim_loop();
+
+            std::mutex _mutex;
+            std::condition_variable _wakeUp;
+            std::condition_variable _idle;
+            std::deque<DiscardedTree> _trees;   //protected by _mutex
+            bool _isFreeing;                    //protected by _mutex
+            bool _isStopping;                   //protected by _mutex
+            std::thread _thread;
+    };
+
+} /* MCTS */
+
+#endif
@@ -0,0 +1,152 @@
+#include "tree_stats.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <utility>
+
+//heap size of a std::list element: the value and the two links
+#define LIST_ELEMENT_BYTES (sizeof(Node*) + 2 * sizeof(void*))
+
+namespace MCTS {
+
+    namespace {
+
+        unsigned int histogram_bucket(unsigned int visits) {
+            unsigned int bucket = 0;
+            while(visits > 1) {
+                visits >>= 1;
+                bucket += 1;
+            }
+            return bucket;
+        }
+
+        /**
+         * \brief Read a memory field of /proc/self/status ("VmRSS:", "VmHWM:"), in bytes
+         *
+         * \return The value, 0 if it can not be read
+         */
+        size_t read_status_bytes(const char* field) {
+#ifdef __linux__
+            std::ifstream status("/proc/self/status");
+            std::string line;
+            while(std::getline(status, line)) {
+                if(line.compare(0, strlen(field), field) == 0)
+                    //kilobytes
+                    return std::stoull(line.substr(strlen(field))) * 1024;
+            }
+#endif
+            return 0;
+        }
+
+        void write_array(std::ostream& os, const std::vector<size_t>& values) {
+            os << "[";
+            for(size_t i = 0; i < values.size(); ++i)
+                os << (i > 0 ? "," : "") << values[i];
+            os << "]";
+        }
+
+    }
+
+    double TreeStats::get_closed_fraction() const {
+        return (nodeCount > 0) ? static_cast<double>(closedCount) / nodeCount : 0.0;
+    }
+
+    double TreeStats::get_mean_branching() const {
+        return (innerNodeCount > 0) ? static_cast<double>(childrenSum) / innerNodeCount : 0.0;
+    }
+
+    size_t TreeStats::get_total_bytes() const {
+        return nodeBytes + stateBytes + unexploredBytes + childrenListBytes;
+    }
+
+    void TreeStats::write_json(std::ostream& os) const {
+        os << "{\"nodes\":" << nodeCount
+            << ",\"closed\":" << closedCount
+            << ",\"closedFraction\":" << this->get_closed_fraction()
+            << ",\"meanBranching\":" << this->get_mean_branching()
+            << ",\"maxBranching\":" << maxBranching
+            << ",\"bytes\":{\"nodes\":" << nodeBytes
+            << ",\"states\":" << stateBytes
+            << ",\"unexploredChildren\":" << unexploredBytes
+            << ",\"childrenLists\":" << childrenListBytes
+            << ",\"total\":" << this->get_total_bytes()
+            << ",\"searchStartResident\":" << searchStartResidentBytes
+            << ",\"searchPeakResident\":" << searchPeakResidentBytes
+            << "},\"depths\":[";
+        for(size_t depth = 0; depth < depths.size(); ++depth) {
+            const DepthStats& stats = depths[depth];
+            os << (depth > 0 ? "," : "")
+                << "{\"depth\":" << depth
+                << ",\"nodes\":" << stats.nodeCount
+                << ",\"closed\":" << stats.closedCount
+                << ",\"meanVisits\":" << ((stats.nodeCount > 0) ? static_cast<double>(stats.visitSum) / stats.nodeCount : 0.0)
+                << ",\"maxVisits\":" << stats.maxVisits
+                << ",\"visitHistogram\":";
+            write_array(os, stats.visitHistogram);
+            os << "}";
+        }
+        os << "]}";
+    }
+
+    size_t start_resident_window() {
+#ifdef __linux__
+        //"5" resets the peak resident memory (VmHWM) of the process to its current value
+        std::ofstream clearRefs("/proc/self/clear_refs");
+        if(clearRefs << "5" << std::flush)
+            return read_status_bytes("VmRSS:");
+#endif
+        return 0;
+    }
+
+    TreeStats compute_tree_stats(const Node* root, size_t searchStartResidentBytes) {
+        TreeStats stats;
+        stats.searchStartResidentBytes = searchStartResidentBytes;
+        if(searchStartResidentBytes > 0)
+            stats.searchPeakResidentBytes = read_status_bytes("VmHWM:");
+
+        std::vector<std::pair<const Node*, unsigned int>> toVisit;
+        toVisit.emplace_back(root, 0);
+        while(not toVisit.empty()) {
+            auto [node, depth] = toVisit.back();
+            toVisit.pop_back();
+
+            if(depth >= stats.depths.size())
+                stats.depths.resize(depth + 1);
+            DepthStats& depthStats = stats.depths[depth];
+
+            const unsigned int visits = node->get_visit_count();
+            const unsigned int bucket = histogram_bucket(visits);
+            if(bucket >= depthStats.visitHistogram.size())
+                depthStats.visitHistogram.resize(bucket + 1, 0);
+            depthStats.visitHistogram[bucket] += 1;
+            depthStats.nodeCount += 1;
+            depthStats.visitSum += visits;
+            depthStats.maxVisits = std::max(depthStats.maxVisits, visits);
+
+            stats.nodeCount += 1;
+            if(node->is_closed()) {
+                stats.closedCount += 1;
+                depthStats.closedCount += 1;
+            }
+
+            const unsigned int childCount = node->get_children().size();
+            if(childCount > 0) {
+                stats.innerNodeCount += 1;
+                stats.childrenSum += childCount;
+                stats.maxBranching = std::max(stats.maxBranching, childCount);
+            }
+
+            stats.nodeBytes += sizeof(Node);
+            stats.stateBytes += node->get_game_state()->get_memory_size();
+            stats.unexploredBytes += node->get_unexplored_capacity() * sizeof(unsigned int);
+            stats.childrenListBytes += childCount * LIST_ELEMENT_BYTES;
+
+            for(const Node* child : node->get_children())
+                toVisit.emplace_back(child, depth + 1);
+        }
+        return stats;
+    }
+
+} /* MCTS */
@@ -0,0 +1,79 @@
+#ifndef MCTS_TREE_STATS_CLASS_HPP
+#define MCTS_TREE_STATS_CLASS_HPP
+
+#include "node.hpp"
+
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+/**
+ * \file    tree_stats.hpp
+ * \author  Baptiste Hudyma
+ * \version 1.0
+ * \date    11 mars 2021
+ *
+ * \brief   Shape and memory report of a search tree
+ */
+
+namespace MCTS {
+
+    /**
+     * \brief   Nodes of a single depth of the tree
+     */
+    struct DepthStats {
+        size_t nodeCount = 0;
+        size_t closedCount = 0;
+        unsigned long long visitSum = 0;
+        unsigned int maxVisits = 0;
+        //visitHistogram[0]: nodes with 0 or 1 visit, visitHistogram[k]: nodes with visits in [2^k, 2^(k + 1)[
+        std::vector<size_t> visitHistogram;
+    };
+
+    /**
+     * \brief   Shape and memory use of a search tree
+     */
+    struct TreeStats {
+        size_t nodeCount = 0;
+        size_t closedCount = 0;
+        size_t innerNodeCount = 0;          //nodes with at least one child
+        unsigned long long childrenSum = 0; //children of the inner nodes
+        unsigned int maxBranching = 0;
+        std::vector<DepthStats> depths;     //indexed by depth, the root at 0
+
+        size_t nodeBytes = 0;               //Node objects
+        size_t stateBytes = 0;              //IGame_State objects, as reported by IGame_State::get_memory_size
+        size_t unexploredBytes = 0;         //_unexploredChildren vectors storage
+        size_t childrenListBytes = 0;       //_children list elements
+        size_t searchStartResidentBytes = 0;    //resident memory of the process when the last search started, 0 if unknown
+        size_t searchPeakResidentBytes = 0;     //peak resident memory of the process since the last search started, 0 if unknown
+
+        double get_closed_fraction() const;
+        double get_mean_branching() const;
+        size_t get_total_bytes() const;
+
+        /**
+         * \brief Write this report as a single JSON object
+         */
+        void write_json(std::ostream& os) const;
+    };
+
+    /**
+     * \brief   Start measuring the peak resident memory from now on, by resetting the peak of the process (Linux /proc/self/clear_refs)
+     * \details The peak is process wide: starting a window in any thread restarts the windows of the other searches
+     *
+     * \return  The current resident memory, 0 if the peak can not be reset
+     */
+    size_t start_resident_window();
+
+    /**
+     * \brief   Walk a tree without recursion to build its report
+     *
+     * \param[in] root                      Root of the tree
+     * \param[in] searchStartResidentBytes  Value of start_resident_window when the last search started, 0 to leave the memory peak unknown
+     */
+    TreeStats compute_tree_stats(const Node* root, size_t searchStartResidentBytes = 0);
+
+} /* MCTS */
+
+#endif